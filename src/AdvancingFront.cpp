@@ -1,86 +1,195 @@
 #include "AdvancingFront.hpp"
 #include "QuickHull.hpp"
-#include <queue>
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
 #include <glm/glm.hpp>
-#include <glm/gtx/vector_angle.hpp>
 
 namespace triangulation {
 
     AdvancingFront::Edge::Edge () {}
 
-    AdvancingFront::Edge::Edge (glm::vec2 _point1, glm::vec2 _point2, bool _is_in_frontier) : point1(_point1), point2(_point2), is_in_frontier(_is_in_frontier) {}
+    AdvancingFront::Edge::Edge (std::uint32_t _vertex1, std::uint32_t _vertex2, bool _is_in_frontier) : vertex1(_vertex1), vertex2(_vertex2), is_in_frontier(_is_in_frontier) {}
 
     bool AdvancingFront::Edge::operator == (Edge const& edge) const {
 
-        Edge inverse_edge(edge.point2, edge.point1, false);
+        return (this->vertex1 == edge.vertex1 && this->vertex2 == edge.vertex2) || (this->vertex1 == edge.vertex2 && this->vertex2 == edge.vertex1);
 
-        return glm::all(glm::equal(this->point1, edge.point1) && glm::equal(this->point2, edge.point2)) || glm::all(glm::equal(this->point1, inverse_edge.point1) && glm::equal(this->point2, inverse_edge.point2));
+    }
+
+    AdvancingFront::EdgeHandle AdvancingFront::EdgePool::create (std::uint32_t vertex1, std::uint32_t vertex2, bool is_in_frontier) {
+
+        this->edges.emplace_back(vertex1, vertex2, is_in_frontier);
+
+        return static_cast<EdgeHandle>(this->edges.size() - 1);
+
+    }
+
+    AdvancingFront::Edge& AdvancingFront::EdgePool::operator [] (EdgeHandle handle) {
+
+        return this->edges[handle];
+
+    }
+
+    AdvancingFront::Edge const& AdvancingFront::EdgePool::operator [] (EdgeHandle handle) const {
+
+        return this->edges[handle];
+
+    }
+
+    std::size_t AdvancingFront::EdgePool::size () const {
+
+        return this->edges.size();
+
+    }
+
+    void AdvancingFront::EdgePool::reserve (std::size_t capacity) {
+
+        this->edges.reserve(capacity);
 
     }
 
-    std::vector<std::shared_ptr<AdvancingFront::Edge>> AdvancingFront::compute_initial_frontier (std::vector<glm::vec2> const& points) {
+    void AdvancingFront::EdgePool::reset () {
+
+        this->edges.clear();
+
+    }
+
+    template <typename Points>
+    std::vector<std::uint32_t> AdvancingFront::compute_canonical_indices (Points const& points, std::vector<std::uint32_t>& sorted_indices) {
+
+        std::vector<std::uint32_t> canonical_indices(points.size());
+
+        sorted_indices.resize(points.size());
+        for (std::uint32_t i = 0; i < points.size(); ++i) {
+
+            sorted_indices[i] = i;
+
+        }
+
+        // Sorting lexicographically so equal points are contiguous, with the smallest index first.
+        std::sort(sorted_indices.begin(), sorted_indices.end(), [&points] (std::uint32_t a, std::uint32_t b) {
 
-        std::vector<std::shared_ptr<Edge>> initial_frontier;
-        std::vector<glm::vec2> convex_hull_points;
+            if (points[a].x != points[b].x) return points[a].x < points[b].x;
+            if (points[a].y != points[b].y) return points[a].y < points[b].y;
+            return a < b;
+
+        });
+
+        for (std::size_t i = 0; i < sorted_indices.size(); ++i) {
+
+            if (i > 0 && glm::all(glm::equal(points[sorted_indices[i]], points[sorted_indices[i-1]]))) {
+
+                canonical_indices[sorted_indices[i]] = canonical_indices[sorted_indices[i-1]];
+
+            } else {
+
+                canonical_indices[sorted_indices[i]] = sorted_indices[i];
+
+            }
+
+        }
+
+        return canonical_indices;
+
+    }
+
+    template <typename Points>
+    void AdvancingFront::compute_initial_frontier (Points const& points, std::vector<glm::vec2> const* hull, std::vector<std::uint32_t> const& canonical_indices, std::vector<std::uint32_t> const& sorted_indices, EdgePool& pool) {
+
+        std::vector<glm::vec2> computed_hull;
+        std::vector<std::uint32_t> convex_hull_indices;
         QuickHull quickhull;
 
-        convex_hull_points = quickhull.compute_hull(points);
-        initial_frontier.reserve(convex_hull_points.size());
+        if (hull == nullptr) {
 
-        for (int i = convex_hull_points.size() - 1; i >= 0; --i) {
+            computed_hull = quickhull.compute_hull(points);
+            hull = &computed_hull;
 
-            initial_frontier.emplace_back(new Edge(convex_hull_points[i], (i == 0) ? convex_hull_points.back() : convex_hull_points[i-1], true));
+        }
+        convex_hull_indices.reserve(hull->size());
+
+        // Locating the hull points among the input points.
+        for (auto const& hull_point : *hull) {
+
+            auto it = std::lower_bound(sorted_indices.begin(), sorted_indices.end(), hull_point, [&points] (std::uint32_t index, glm::vec2 const& point) {
+
+                return points[index].x < point.x || (points[index].x == point.x && points[index].y < point.y);
+
+            });
+            if (it == sorted_indices.end() || !glm::all(glm::equal(points[*it], hull_point))) throw std::invalid_argument("Error: Convex hull point is not one of the points!");
+            convex_hull_indices.push_back(canonical_indices[*it]);
 
         }
 
-        return initial_frontier;
+        for (int i = convex_hull_indices.size() - 1; i >= 0; --i) {
+
+            pool.create(convex_hull_indices[i], (i == 0) ? convex_hull_indices.back() : convex_hull_indices[i-1], true);
+
+        }
 
     }
 
-    std::optional<glm::vec2> AdvancingFront::find_candidate_point (Edge const& edge, std::vector<std::shared_ptr<Edge>> const& edges, std::vector<glm::vec2> const& points) {
+    template <typename Points>
+    std::optional<std::uint32_t> AdvancingFront::find_candidate_point (Edge const& edge, EdgePool const& pool, Points const& points, std::vector<std::uint32_t> const& canonical_indices, RunContext const* context) {
 
-        std::optional<glm::vec2> candidate_point;
+        std::optional<std::uint32_t> candidate_point;
         glm::vec2
-            edge_vector = edge.point2 - edge.point1;
+            edge_point1 = points[edge.vertex1],
+            edge_point2 = points[edge.vertex2],
+            edge_vector = edge_point2 - edge_point1;
         float
-            angle, triangle_area,
-            max_angle = -INFINITY,
+            triangle_area,
             min_triangle_area = INFINITY;
+        double
+            angle,
+            max_angle = -INFINITY;
         bool is_a_valid_point;
         std::size_t i;
 
         // Finding the valid point with the minimum distance from the edge.
-        for (auto const& point : points) {
+        for (std::uint32_t index = 0; index < points.size(); ++index) {
+
+            // Each point is checked against every edge, so polling the context every 256 points costs nothing noticeable.
+            if (context != nullptr && index % 256 == 0 && context->should_stop()) return std::nullopt;
 
-            if (glm::cross(glm::vec3(edge_vector, 0.0f), glm::vec3(point - edge.point1, 0.0f)).z > 0) {
+            glm::vec2 point = points[index];
+
+            if (glm::cross(glm::vec3(edge_vector, 0.0f), glm::vec3(point - edge_point1, 0.0f)).z > 0) {
 
                 // Checking if it is a valid point (no intersection).
                 is_a_valid_point = true;
                 i = 0;
-                while (is_a_valid_point && i < edges.size()) {
+                while (is_a_valid_point && i < pool.size()) {
 
-                    is_a_valid_point = !check_intersection(*edges[i], Edge(edge.point1, point, false)) && !check_intersection(*edges[i], Edge(edge.point2, point, false));
+                    Edge const& other = pool[i];
+                    is_a_valid_point = !check_intersection(points[other.vertex1], points[other.vertex2], edge_point1, point) && !check_intersection(points[other.vertex1], points[other.vertex2], edge_point2, point);
                     ++i;
 
                 }
 
                 if (is_a_valid_point) {
 
-                    angle = glm::angle(edge.point1 - point, edge.point2 - point);
+                    // glm::angle expects unit vectors; atan2 of the cross and dot products needs no normalization and stays
+                    // accurate for angles near 0 and pi, where acos of the dot product loses most of its precision.
+                    glm::dvec2
+                        to_point1 = glm::dvec2(edge_point1) - glm::dvec2(point),
+                        to_point2 = glm::dvec2(edge_point2) - glm::dvec2(point);
+                    angle = std::atan2(std::abs(to_point1.x * to_point2.y - to_point1.y * to_point2.x), to_point1.x * to_point2.x + to_point1.y * to_point2.y);
 
                     if (angle > max_angle) {
 
                         max_angle = angle;
-                        candidate_point = point;
+                        candidate_point = canonical_indices[index];
 
                     } else if (angle == max_angle) {
 
-                        triangle_area = glm::cross(glm::vec3(edge_vector, 0.0f), glm::vec3(point - edge.point1, 0.0f)).z/2.0f;
+                        triangle_area = glm::cross(glm::vec3(edge_vector, 0.0f), glm::vec3(point - edge_point1, 0.0f)).z/2.0f;
 
                         if (triangle_area < min_triangle_area) {
 
                             min_triangle_area = triangle_area;
-                            candidate_point = point;
+                            candidate_point = canonical_indices[index];
 
                         }
 
@@ -96,97 +205,184 @@ namespace triangulation {
 
     }
 
-    bool AdvancingFront::check_intersection (Edge const& e1, Edge const& e2) {
+    bool AdvancingFront::check_intersection (glm::vec2 const& e1_point1, glm::vec2 const& e1_point2, glm::vec2 const& e2_point1, glm::vec2 const& e2_point2) {
 
         return
-            glm::cross(glm::vec3(e1.point2 - e1.point1, 0.0f), glm::vec3(e2.point1 - e1.point1, 0.0f)).z * glm::cross(glm::vec3(e1.point2 - e1.point1, 0.0f), glm::vec3(e2.point2 - e1.point1, 0.0f)).z < 0
+            glm::cross(glm::vec3(e1_point2 - e1_point1, 0.0f), glm::vec3(e2_point1 - e1_point1, 0.0f)).z * glm::cross(glm::vec3(e1_point2 - e1_point1, 0.0f), glm::vec3(e2_point2 - e1_point1, 0.0f)).z < 0
             &&
-            glm::cross(glm::vec3(e2.point2 - e2.point1, 0.0f), glm::vec3(e1.point1 - e2.point1, 0.0f)).z * glm::cross(glm::vec3(e2.point2 - e2.point1, 0.0f), glm::vec3(e1.point2 - e2.point1, 0.0f)).z < 0;
+            glm::cross(glm::vec3(e2_point2 - e2_point1, 0.0f), glm::vec3(e1_point1 - e2_point1, 0.0f)).z * glm::cross(glm::vec3(e2_point2 - e2_point1, 0.0f), glm::vec3(e1_point2 - e2_point1, 0.0f)).z < 0;
 
     }
 
-    std::shared_ptr<AdvancingFront::Edge> AdvancingFront::find_edge_pointer (glm::vec2 point1, glm::vec2 point2, std::vector<std::shared_ptr<Edge>> const& frontier) {
+    AdvancingFront::EdgeHandle AdvancingFront::find_edge (std::uint32_t vertex1, std::uint32_t vertex2, EdgePool const& pool) {
+
+        Edge edge(vertex1, vertex2, false);
 
-        for (auto const& e : frontier) {
+        for (EdgeHandle handle = 0; handle < pool.size(); ++handle) {
 
-            if (Edge(point1, point2, false) == *e) {
+            if (edge == pool[handle]) {
 
-                return e;
+                return handle;
 
             }
 
         }
 
-        return nullptr;
+        return null_edge;
 
     }
 
     std::vector<glm::vec2> AdvancingFront::compute_triangulation (std::vector<glm::vec2> const& points) {
 
+        std::vector<std::uint32_t> indices = AdvancingFront::compute_triangulation_indices(points);
+        std::vector<glm::vec2> triangles;
+
+        triangles.reserve(indices.size());
+        for (auto const& index : indices) {
+
+            triangles.push_back(points[index]);
+
+        }
+
+        return triangles;
+
+    }
+
+    std::vector<std::uint32_t> AdvancingFront::compute_triangulation_indices (std::vector<glm::vec2> const& points) {
+
+        return AdvancingFront::triangulate(points, nullptr, nullptr, nullptr).indices;
+
+    }
+
+    std::vector<glm::vec2> AdvancingFront::compute_triangulation (CompactPoints const& points) {
+
+        std::vector<std::uint32_t> indices = AdvancingFront::compute_triangulation_indices(points);
         std::vector<glm::vec2> triangles;
-        std::vector<std::shared_ptr<Edge>> frontier = AdvancingFront::compute_initial_frontier(points);
-        std::queue<std::shared_ptr<Edge>> edges_queue;
-        std::shared_ptr<Edge> current_edge, new_edge1, new_edge2;
-        std::optional<glm::vec2> candidate_point;
 
-        for (auto const& edge : frontier) {
+        triangles.reserve(indices.size());
+        for (auto const& index : indices) {
 
-            edges_queue.push(edge);
+            triangles.push_back(points[index]);
 
         }
 
-        while (!edges_queue.empty()) {
+        return triangles;
+
+    }
+
+    std::vector<std::uint32_t> AdvancingFront::compute_triangulation_indices (CompactPoints const& points) {
 
-            current_edge = std::move(edges_queue.front());
-            edges_queue.pop();
+        return AdvancingFront::triangulate(points, nullptr, nullptr, nullptr).indices;
 
-            if (current_edge->is_in_frontier) {
+    }
 
-                candidate_point = AdvancingFront::find_candidate_point(*current_edge, frontier, points);
+    std::vector<std::uint32_t> AdvancingFront::compute_triangulation_indices (std::vector<glm::vec2> const& points, Observer const& observer) {
 
-                if (candidate_point.has_value()) {
+        return AdvancingFront::triangulate(points, nullptr, &observer, observer.context).indices;
 
-                    triangles.push_back(current_edge->point1);
-                    triangles.push_back(current_edge->point2);
-                    triangles.push_back(candidate_point.value());
+    }
 
-                    // Updating the frontier.
-                    current_edge->is_in_frontier = false;
+    std::vector<std::uint32_t> AdvancingFront::compute_triangulation_indices (CompactPoints const& points, Observer const& observer) {
 
-                    new_edge1 = AdvancingFront::find_edge_pointer(current_edge->point1, candidate_point.value(), frontier);
-                    if (new_edge1 == nullptr) {
+        return AdvancingFront::triangulate(points, nullptr, &observer, observer.context).indices;
 
-                        new_edge1 = std::make_shared<Edge>(current_edge->point1, candidate_point.value(), true);
-                        frontier.push_back(new_edge1);
-                        edges_queue.push(new_edge1);
+    }
 
-                    } else {
+    std::vector<std::uint32_t> AdvancingFront::compute_triangulation_indices (std::vector<glm::vec2> const& points, std::vector<glm::vec2> const& hull) {
 
-                        new_edge1->is_in_frontier = false;
+        return AdvancingFront::triangulate(points, &hull, nullptr, nullptr).indices;
 
-                    }
+    }
 
-                    new_edge2 = AdvancingFront::find_edge_pointer(candidate_point.value(), current_edge->point2, frontier);
-                    if (new_edge2 == nullptr) {
+    std::vector<std::uint32_t> AdvancingFront::compute_triangulation_indices (std::vector<glm::vec2> const& points, std::vector<glm::vec2> const& hull, Observer const& observer) {
 
-                        new_edge2 = std::make_shared<Edge>(candidate_point.value(), current_edge->point2, true);
-                        frontier.push_back(new_edge2);
-                        edges_queue.push(new_edge2);
+        return AdvancingFront::triangulate(points, &hull, &observer, observer.context).indices;
 
-                    } else {
+    }
 
-                        new_edge2->is_in_frontier = false;
+    AdvancingFront::Result AdvancingFront::compute_triangulation_indices (std::vector<glm::vec2> const& points, RunContext const& context) {
 
-                    }
+        return AdvancingFront::triangulate(points, nullptr, nullptr, &context);
 
-                }
+    }
+
+    AdvancingFront::Result AdvancingFront::compute_triangulation_indices (CompactPoints const& points, RunContext const& context) {
+
+        return AdvancingFront::triangulate(points, nullptr, nullptr, &context);
+
+    }
+
+    AdvancingFront::Result AdvancingFront::compute_triangulation_indices (std::vector<glm::vec2> const& points, std::vector<glm::vec2> const& hull, RunContext const& context) {
+
+        return AdvancingFront::triangulate(points, &hull, nullptr, &context);
+
+    }
+
+    std::vector<std::uint32_t> AdvancingFront::get_frontier (EdgePool const& pool) {
+
+        std::vector<std::uint32_t> frontier;
+
+        for (EdgeHandle handle = 0; handle < pool.size(); ++handle) {
+
+            if (pool[handle].is_in_frontier) {
+
+                frontier.push_back(pool[handle].vertex1);
+                frontier.push_back(pool[handle].vertex2);
 
             }
 
         }
 
-        return triangles;
+        return frontier;
 
     }
 
-}
\ No newline at end of file
+    AdvancingFront::EdgePool& AdvancingFront::acquire_pool () {
+
+        static thread_local EdgePool pool;
+
+        pool.reset();
+        return pool;
+
+    }
+
+    template <typename Points>
+    AdvancingFront::Result AdvancingFront::triangulate (Points const& points, std::vector<glm::vec2> const* hull, Observer const* observer, RunContext const* context) {
+
+        Result result;
+        EdgePool& pool = AdvancingFront::acquire_pool();
+
+        auto sink = [&result, &pool, observer] (std::uint32_t vertex1, std::uint32_t vertex2, std::uint32_t vertex3) {
+
+            result.indices.push_back(vertex1);
+            result.indices.push_back(vertex2);
+            result.indices.push_back(vertex3);
+
+            if (observer != nullptr) {
+
+                if (observer->on_triangle) observer->on_triangle(vertex1, vertex2, vertex3);
+                if (observer->on_frontier && observer->frontier_interval > 0 && (result.indices.size()/3) % observer->frontier_interval == 0) observer->on_frontier(AdvancingFront::get_frontier(pool));
+
+            }
+
+        };
+
+        result.stop_reason = AdvancingFront::advance_front(points, hull, pool, sink, context);
+        result.is_partial = result.stop_reason != RunContext::NOT_STOPPED;
+
+        if (observer != nullptr && observer->on_frontier) observer->on_frontier(AdvancingFront::get_frontier(pool));
+        if (result.is_partial) result.frontier = AdvancingFront::get_frontier(pool);
+
+        return result;
+
+    }
+
+    // The helpers of advance_front, which is defined in the header, for the supported point containers.
+    template std::vector<std::uint32_t> AdvancingFront::compute_canonical_indices (std::vector<glm::vec2> const&, std::vector<std::uint32_t>&);
+    template std::vector<std::uint32_t> AdvancingFront::compute_canonical_indices (CompactPoints const&, std::vector<std::uint32_t>&);
+    template void AdvancingFront::compute_initial_frontier (std::vector<glm::vec2> const&, std::vector<glm::vec2> const*, std::vector<std::uint32_t> const&, std::vector<std::uint32_t> const&, EdgePool&);
+    template void AdvancingFront::compute_initial_frontier (CompactPoints const&, std::vector<glm::vec2> const*, std::vector<std::uint32_t> const&, std::vector<std::uint32_t> const&, EdgePool&);
+    template std::optional<std::uint32_t> AdvancingFront::find_candidate_point (Edge const&, EdgePool const&, std::vector<glm::vec2> const&, std::vector<std::uint32_t> const&, RunContext const*);
+    template std::optional<std::uint32_t> AdvancingFront::find_candidate_point (Edge const&, EdgePool const&, CompactPoints const&, std::vector<std::uint32_t> const&, RunContext const*);
+
+}
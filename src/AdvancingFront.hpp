@@ -2,42 +2,283 @@
 #define TRIANGULATION_ADVANCINGFRONT_HPP
 
 #include <vector>
-#include <memory>
+#include <cstdint>
+#include <limits>
 #include <optional>
+#include <atomic>
+#include <functional>
+#include <queue>
+#include <type_traits>
 #include <glm/vec2.hpp>
+#include "CompactPoints.hpp"
+#include "RunContext.hpp"
 
 namespace triangulation {
 
     class AdvancingFront {
 
+        public:
+
+            // Hooks used to follow (and stop) a triangulation while it runs.
+            struct Observer {
+
+                // Called after each new triangle, with its indices into the points.
+                std::function<void (std::uint32_t, std::uint32_t, std::uint32_t)> on_triangle;
+                // Called every frontier_interval triangles and at the end of the run with the edges currently in the frontier, as pairs of indices.
+                std::function<void (std::vector<std::uint32_t> const&)> on_frontier;
+                std::size_t frontier_interval = 256;
+                // When set, the run stops as soon as the context says so (cancelled or past its deadline) and returns the triangles found so far.
+                RunContext const* context = nullptr;
+
+            };
+
+            // Outcome of a run that can be stopped early.
+            struct Result {
+
+                std::vector<std::uint32_t> indices;
+                // Edges left in the frontier, as pairs of indices, when the run was stopped (empty otherwise).
+                std::vector<std::uint32_t> frontier;
+                bool is_partial = false;
+                RunContext::StopReason stop_reason = RunContext::NOT_STOPPED;
+
+            };
+
         private:
 
+            // 32-bit handle to an edge stored in an EdgePool.
+            using EdgeHandle = std::uint32_t;
+            static constexpr EdgeHandle null_edge = std::numeric_limits<EdgeHandle>::max();
+
             struct Edge {
 
-                glm::vec2 point1, point2;
+                // Endpoints as (canonical) indices into the input points.
+                std::uint32_t vertex1, vertex2;
                 bool is_in_frontier;
 
                 Edge ();
-                Edge (glm::vec2 _point1, glm::vec2 _point2, bool _is_in_frontier);
+                Edge (std::uint32_t _vertex1, std::uint32_t _vertex2, bool _is_in_frontier);
 
                 bool operator == (Edge const& edge) const;
 
             };
 
-            static std::vector<std::shared_ptr<Edge>> compute_initial_frontier (std::vector<glm::vec2> const& points);
+            // Contiguous arena holding every edge created during a run.
+            // Edges are never freed individually, the whole pool is reset at the end of the run.
+            class EdgePool {
+
+                private:
+
+                    std::vector<Edge> edges;
+
+                public:
+
+                    EdgeHandle create (std::uint32_t vertex1, std::uint32_t vertex2, bool is_in_frontier);
+
+                    Edge& operator [] (EdgeHandle handle);
+                    Edge const& operator [] (EdgeHandle handle) const;
+
+                    std::size_t size () const;
+
+                    void reserve (std::size_t capacity);
+
+                    // Drops all edges at once, keeping the allocated memory for the next run.
+                    void reset ();
+
+            };
 
-            static std::optional<glm::vec2> find_candidate_point (Edge const& edge, std::vector<std::shared_ptr<Edge>> const& edges, std::vector<glm::vec2> const& points);
+            // Points is any container with size() and operator[] returning a glm::vec2 (std::vector<glm::vec2> or CompactPoints).
 
-            static bool check_intersection (Edge const& e1, Edge const& e2);
+            // Maps each point to the smallest index having the same coordinates, so duplicated points share edges.
+            template <typename Points>
+            static std::vector<std::uint32_t> compute_canonical_indices (Points const& points, std::vector<std::uint32_t>& sorted_indices);
 
-            static std::shared_ptr<Edge> find_edge_pointer (glm::vec2 point1, glm::vec2 point2, std::vector<std::shared_ptr<Edge>> const& frontier);
+            // Uses the given convex hull of the points if there is one, or computes it.
+            template <typename Points>
+            static void compute_initial_frontier (Points const& points, std::vector<glm::vec2> const* hull, std::vector<std::uint32_t> const& canonical_indices, std::vector<std::uint32_t> const& sorted_indices, EdgePool& pool);
+
+            // Returns no point if the context stops the run during the scan.
+            template <typename Points>
+            static std::optional<std::uint32_t> find_candidate_point (Edge const& edge, EdgePool const& pool, Points const& points, std::vector<std::uint32_t> const& canonical_indices, RunContext const* context);
+
+            static std::vector<std::uint32_t> get_frontier (EdgePool const& pool);
+
+            // Edge pool of the calling thread, emptied. It keeps its capacity between runs, so a sink must not start another run on the same thread.
+            static EdgePool& acquire_pool ();
+
+            // Passes a triangle to a callable sink, or writes its indices through an output iterator.
+            template <typename Sink>
+            static void emit (Sink& sink, std::uint32_t vertex1, std::uint32_t vertex2, std::uint32_t vertex3);
+
+            // The frontier loop shared by every run: each triangle goes to the sink as soon as it is created.
+            // Returns why the context stopped the run, if it did, leaving the frontier in the pool.
+            // Points is std::vector<glm::vec2> or CompactPoints, the types the helpers are instantiated for.
+            template <typename Points, typename Sink>
+            static RunContext::StopReason advance_front (Points const& points, std::vector<glm::vec2> const* hull, EdgePool& pool, Sink& sink, RunContext const* context);
+
+            template <typename Points>
+            static Result triangulate (Points const& points, std::vector<glm::vec2> const* hull, Observer const* observer, RunContext const* context);
+
+            static bool check_intersection (glm::vec2 const& e1_point1, glm::vec2 const& e1_point2, glm::vec2 const& e2_point1, glm::vec2 const& e2_point2);
+
+            static EdgeHandle find_edge (std::uint32_t vertex1, std::uint32_t vertex2, EdgePool const& pool);
 
         public:
 
             static std::vector<glm::vec2> compute_triangulation (std::vector<glm::vec2> const& points) ;
 
+            // Same as compute_triangulation, but each triangle is given by three indices into points.
+            static std::vector<std::uint32_t> compute_triangulation_indices (std::vector<glm::vec2> const& points);
+
+            // Triangulates quantized points, reading them through CompactPoints::operator[].
+            // Only the output triangles are dequantized.
+            static std::vector<glm::vec2> compute_triangulation (CompactPoints const& points);
+            static std::vector<std::uint32_t> compute_triangulation_indices (CompactPoints const& points);
+
+            // Same as compute_triangulation_indices, reporting progress to the observer.
+            static std::vector<std::uint32_t> compute_triangulation_indices (std::vector<glm::vec2> const& points, Observer const& observer);
+            static std::vector<std::uint32_t> compute_triangulation_indices (CompactPoints const& points, Observer const& observer);
+
+            // Same as compute_triangulation_indices, starting from an already known convex hull of the points
+            // (as returned by QuickHull::compute_hull or QuickHull::merge_hulls), whose vertices must be among the points.
+            static std::vector<std::uint32_t> compute_triangulation_indices (std::vector<glm::vec2> const& points, std::vector<glm::vec2> const& hull);
+            static std::vector<std::uint32_t> compute_triangulation_indices (std::vector<glm::vec2> const& points, std::vector<glm::vec2> const& hull, Observer const& observer);
+
+            // Same as compute_triangulation_indices, stopping early when the context says so: the result is then marked partial
+            // and holds the triangles found so far with the frontier left. The context is checked before each frontier edge
+            // and periodically while scanning for its candidate point.
+            static Result compute_triangulation_indices (std::vector<glm::vec2> const& points, RunContext const& context);
+            static Result compute_triangulation_indices (CompactPoints const& points, RunContext const& context);
+            static Result compute_triangulation_indices (std::vector<glm::vec2> const& points, std::vector<glm::vec2> const& hull, RunContext const& context);
+
+            // Emits each triangle to the sink as soon as it is created, with nothing stored in between. The sink is either
+            // callable as sink(vertex1, vertex2, vertex3) with indices into points (a lambda, a TriangleRingBuffer, ...) or
+            // an output iterator receiving the three indices; it is a template parameter so that the call is inlined.
+            // Returns why the context stopped the run early, or NOT_STOPPED once every triangle was emitted.
+            template <typename Sink>
+            static RunContext::StopReason compute_triangulation (std::vector<glm::vec2> const& points, Sink&& sink, RunContext const* context = nullptr);
+            template <typename Sink>
+            static RunContext::StopReason compute_triangulation (CompactPoints const& points, Sink&& sink, RunContext const* context = nullptr);
+
     };
 
+    template <typename Sink>
+    void AdvancingFront::emit (Sink& sink, std::uint32_t vertex1, std::uint32_t vertex2, std::uint32_t vertex3) {
+
+        if constexpr (std::is_invocable_v<Sink&, std::uint32_t, std::uint32_t, std::uint32_t>) {
+
+            sink(vertex1, vertex2, vertex3);
+
+        } else {
+
+            *sink = vertex1;
+            ++sink;
+            *sink = vertex2;
+            ++sink;
+            *sink = vertex3;
+            ++sink;
+
+        }
+
+    }
+
+    template <typename Points, typename Sink>
+    RunContext::StopReason AdvancingFront::advance_front (Points const& points, std::vector<glm::vec2> const* hull, EdgePool& pool, Sink& sink, RunContext const* context) {
+
+        std::vector<std::uint32_t> sorted_indices;
+        std::vector<std::uint32_t> canonical_indices = AdvancingFront::compute_canonical_indices(points, sorted_indices);
+        std::queue<EdgeHandle> edges_queue;
+        EdgeHandle current_edge, new_edge1, new_edge2;
+        std::uint32_t vertex1, vertex2;
+        std::optional<std::uint32_t> candidate_point;
+        RunContext::StopReason stop_reason = RunContext::NOT_STOPPED;
+
+        auto should_stop = [&stop_reason, context] () {
+
+            if (context != nullptr) stop_reason = context->get_stop_reason();
+            return stop_reason != RunContext::NOT_STOPPED;
+
+        };
+
+        // A triangulation of n points has less than 3n edges.
+        pool.reserve(3*points.size());
+        AdvancingFront::compute_initial_frontier(points, hull, canonical_indices, sorted_indices, pool);
+
+        for (EdgeHandle handle = 0; handle < pool.size(); ++handle) {
+
+            edges_queue.push(handle);
+
+        }
+
+        while (!edges_queue.empty()) {
+
+            current_edge = edges_queue.front();
+            edges_queue.pop();
+
+            // Edges that left the frontier are skipped without polling the context: the candidate scan polls it first thing,
+            // so it is checked once per frontier edge and every 256 points while scanning, never on the cheap pops.
+            if (pool[current_edge].is_in_frontier) {
+
+                candidate_point = AdvancingFront::find_candidate_point(pool[current_edge], pool, points, canonical_indices, context);
+
+                // The scan was interrupted: the edge stays in the frontier.
+                if (!candidate_point.has_value() && should_stop()) break;
+
+                if (candidate_point.has_value()) {
+
+                    vertex1 = pool[current_edge].vertex1;
+                    vertex2 = pool[current_edge].vertex2;
+
+                    // Updating the frontier.
+                    pool[current_edge].is_in_frontier = false;
+
+                    new_edge1 = AdvancingFront::find_edge(vertex1, candidate_point.value(), pool);
+                    if (new_edge1 == null_edge) {
+
+                        edges_queue.push(pool.create(vertex1, candidate_point.value(), true));
+
+                    } else {
+
+                        pool[new_edge1].is_in_frontier = false;
+
+                    }
+
+                    new_edge2 = AdvancingFront::find_edge(candidate_point.value(), vertex2, pool);
+                    if (new_edge2 == null_edge) {
+
+                        edges_queue.push(pool.create(candidate_point.value(), vertex2, true));
+
+                    } else {
+
+                        pool[new_edge2].is_in_frontier = false;
+
+                    }
+
+                    AdvancingFront::emit(sink, vertex1, vertex2, candidate_point.value());
+
+                }
+
+            }
+
+        }
+
+        return stop_reason;
+
+    }
+
+    template <typename Sink>
+    RunContext::StopReason AdvancingFront::compute_triangulation (std::vector<glm::vec2> const& points, Sink&& sink, RunContext const* context) {
+
+        return AdvancingFront::advance_front(points, nullptr, AdvancingFront::acquire_pool(), sink, context);
+
+    }
+
+    template <typename Sink>
+    RunContext::StopReason AdvancingFront::compute_triangulation (CompactPoints const& points, Sink&& sink, RunContext const* context) {
+
+        return AdvancingFront::advance_front(points, nullptr, AdvancingFront::acquire_pool(), sink, context);
+
+    }
+
 }
 
-#endif
\ No newline at end of file
+#endif
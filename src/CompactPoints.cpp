@@ -0,0 +1,129 @@
+#include "CompactPoints.hpp"
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <glm/glm.hpp>
+
+namespace triangulation {
+
+    CompactPoints::CompactPoints () : count(0), bits(16), bytes_per_point(4), min_corner(0.0f), step(0.0f), max_error(0.0f) {}
+
+    CompactPoints::CompactPoints (std::vector<glm::vec2> const& points, unsigned int _bits) : CompactPoints(glm::vec2(0.0f), glm::vec2(0.0f), _bits) {
+
+        if (points.empty()) return;
+
+        glm::vec2 min_corner = points[0], max_corner = points[0];
+
+        for (auto const& point : points) {
+
+            min_corner = glm::min(min_corner, point);
+            max_corner = glm::max(max_corner, point);
+
+        }
+
+        *this = CompactPoints(min_corner, max_corner, _bits);
+        this->reserve(points.size());
+        for (auto const& point : points) {
+
+            this->push_back(point);
+
+        }
+
+    }
+
+    CompactPoints::CompactPoints (glm::vec2 _min_corner, glm::vec2 max_corner, unsigned int _bits) : count(0), bits(_bits), min_corner(_min_corner), step(0.0f), max_error(0.0f) {
+
+        if (this->bits < 1 || this->bits > 24) throw std::invalid_argument("Invalid quantization precision: " + std::to_string(this->bits) + " bits (must be between 1 and 24)!");
+
+        this->bytes_per_point = (2*this->bits + 7)/8;
+        this->step = (max_corner - this->min_corner)/static_cast<float>((1u << this->bits) - 1);
+
+    }
+
+    void CompactPoints::reserve (std::size_t capacity) {
+
+        this->data.reserve(capacity*this->bytes_per_point);
+
+    }
+
+    void CompactPoints::push_back (glm::vec2 point) {
+
+        std::uint64_t
+            x = (this->step.x > 0.0f) ? static_cast<std::uint64_t>(std::lround((point.x - this->min_corner.x)/this->step.x)) : 0,
+            y = (this->step.y > 0.0f) ? static_cast<std::uint64_t>(std::lround((point.y - this->min_corner.y)/this->step.y)) : 0,
+            packed = x | (y << this->bits);
+
+        for (std::size_t b = 0; b < this->bytes_per_point; ++b) {
+
+            this->data.push_back(static_cast<std::uint8_t>(packed >> (8*b)));
+
+        }
+        this->count++;
+
+        glm::vec2 error = glm::abs((*this)[this->count - 1] - point);
+        this->max_error = std::max(this->max_error, std::max(error.x, error.y));
+
+    }
+
+    std::size_t CompactPoints::size () const {
+
+        return this->count;
+
+    }
+
+    bool CompactPoints::empty () const {
+
+        return this->count == 0;
+
+    }
+
+    unsigned int CompactPoints::get_bits () const {
+
+        return this->bits;
+
+    }
+
+    std::size_t CompactPoints::get_memory_usage () const {
+
+        return this->data.size();
+
+    }
+
+    float CompactPoints::get_max_error () const {
+
+        return this->max_error;
+
+    }
+
+    glm::vec2 CompactPoints::operator [] (std::size_t index) const {
+
+        const std::uint8_t* bytes = this->data.data() + index*this->bytes_per_point;
+        const std::uint64_t mask = (std::uint64_t(1) << this->bits) - 1;
+        std::uint64_t packed = 0;
+
+        for (std::size_t b = 0; b < this->bytes_per_point; ++b) {
+
+            packed |= std::uint64_t(bytes[b]) << (8*b);
+
+        }
+
+        return this->min_corner + this->step*glm::vec2(static_cast<float>(packed & mask), static_cast<float>(packed >> this->bits));
+
+    }
+
+    std::vector<glm::vec2> CompactPoints::dequantize () const {
+
+        std::vector<glm::vec2> points;
+
+        points.reserve(this->count);
+        for (std::size_t i = 0; i < this->count; ++i) {
+
+            points.push_back((*this)[i]);
+
+        }
+
+        return points;
+
+    }
+
+}
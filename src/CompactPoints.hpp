@@ -0,0 +1,58 @@
+#ifndef TRIANGULATION_COMPACTPOINTS_HPP
+#define TRIANGULATION_COMPACTPOINTS_HPP
+
+#include <vector>
+#include <cstdint>
+#include <glm/vec2.hpp>
+
+namespace triangulation {
+
+    // Point storage with coordinates quantized relative to the bounding box of the points.
+    // Each point takes 2*bits bits rounded up to whole bytes (4 bytes for 16 bits, 6 bytes for 21 bits), instead of the 8 bytes of a glm::vec2.
+    class CompactPoints {
+
+        private:
+
+            std::vector<std::uint8_t> data;
+            std::size_t count;
+            unsigned int bits;
+            std::size_t bytes_per_point;
+            glm::vec2 min_corner, step;
+            float max_error;
+
+        public:
+
+            CompactPoints ();
+            // Quantizes the points using the given number of bits per coordinate (between 1 and 24).
+            CompactPoints (std::vector<glm::vec2> const& points, unsigned int _bits = 16);
+            // Prepares to quantize points within the given bounding box, added with push_back, so that loaders can fill it without
+            // keeping the points as glm::vec2 first.
+            CompactPoints (glm::vec2 _min_corner, glm::vec2 max_corner, unsigned int _bits = 16);
+
+            void reserve (std::size_t capacity);
+
+            // Quantizes and appends a point, which must lie within the bounding box.
+            void push_back (glm::vec2 point);
+
+            std::size_t size () const;
+            bool empty () const;
+
+            unsigned int get_bits () const;
+
+            // Bytes used by the quantized coordinates.
+            std::size_t get_memory_usage () const;
+
+            // Largest distance, along either axis, between an input point and its quantized position.
+            float get_max_error () const;
+
+            // Dequantizes a single point.
+            glm::vec2 operator [] (std::size_t index) const;
+
+            // Dequantizes all points.
+            std::vector<glm::vec2> dequantize () const;
+
+    };
+
+}
+
+#endif
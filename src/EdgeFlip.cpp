@@ -0,0 +1,336 @@
+#include "EdgeFlip.hpp"
+#include "Parallel.hpp"
+#include <atomic>
+#include <cmath>
+#include <stdexcept>
+#include <glm/glm.hpp>
+
+namespace triangulation {
+
+    namespace {
+
+        double orientation (glm::dvec2 a, glm::dvec2 b, glm::dvec2 c) {
+
+            return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+
+        }
+
+        // Bijective mix of a half-edge index: claiming by scrambled priority rather than by index avoids long chains of edges
+        // each waiting for its smaller neighbour, which would take one round per edge.
+        std::uint32_t get_priority (std::uint32_t h) {
+
+            h ^= h >> 16;
+            h *= 0x7FEB352Du;
+            h ^= h >> 15;
+            h *= 0x846CA68Bu;
+            h ^= h >> 16;
+            return h;
+
+        }
+
+    }
+
+    bool EdgeFlip::is_in_circle (glm::vec2 a, glm::vec2 b, glm::vec2 c, glm::vec2 d) {
+
+        double
+            adx = static_cast<double>(a.x) - d.x, ady = static_cast<double>(a.y) - d.y,
+            bdx = static_cast<double>(b.x) - d.x, bdy = static_cast<double>(b.y) - d.y,
+            cdx = static_cast<double>(c.x) - d.x, cdy = static_cast<double>(c.y) - d.y,
+            a_lift = adx * adx + ady * ady,
+            b_lift = bdx * bdx + bdy * bdy,
+            c_lift = cdx * cdx + cdy * cdy,
+            determinant = a_lift * (bdx * cdy - cdx * bdy) + b_lift * (cdx * ady - adx * cdy) + c_lift * (adx * bdy - bdx * ady),
+            permanent = a_lift * (std::abs(bdx * cdy) + std::abs(cdx * bdy)) + b_lift * (std::abs(cdx * ady) + std::abs(adx * cdy)) + c_lift * (std::abs(adx * bdy) + std::abs(bdx * ady));
+
+        // Cocircular points within the rounding error are left alone, so that they are not flipped back and forth.
+        return determinant > 1e-12 * permanent;
+
+    }
+
+    EdgeFlip::Statistics EdgeFlip::make_delaunay (std::vector<glm::vec2> const& points, std::vector<std::uint32_t>& indices, unsigned int thread_count, std::size_t max_rounds) {
+
+        if (indices.size() % 3 != 0) throw std::invalid_argument("Error: Triangle indices count is not a multiple of 3!");
+
+        Statistics statistics;
+        std::size_t
+            triangle_count = indices.size() / 3,
+            half_edge_count = indices.size();
+        std::vector<std::uint32_t>
+            half_edge_offsets(points.size() + 1, 0),
+            half_edges_by_origin(half_edge_count),
+            twins(half_edge_count, no_half_edge);
+
+        // The same threads serve every round.
+        WorkerPool workers(thread_count);
+        thread_count = workers.get_thread_count();
+
+        for (auto const& index : indices) {
+
+            if (index >= points.size()) throw std::out_of_range("Error: Triangle index out of range!");
+
+        }
+
+        workers.parallel_for(triangle_count, [&] (std::size_t begin, std::size_t end) {
+
+            for (std::size_t t = begin; t < end; t++) {
+
+                if (orientation(glm::dvec2(points[indices[3*t]]), glm::dvec2(points[indices[3*t + 1]]), glm::dvec2(points[indices[3*t + 2]])) < 0.0) {
+
+                    std::swap(indices[3*t + 1], indices[3*t + 2]);
+
+                }
+
+            }
+
+        });
+
+        // Half-edge h goes from indices[h] to the next corner of its triangle; its twin is found among the half-edges leaving its destination.
+        auto next = [] (std::uint32_t h) { return (h % 3 == 2) ? h - 2 : h + 1; };
+        auto previous = [] (std::uint32_t h) { return (h % 3 == 0) ? h + 2 : h - 1; };
+
+        for (std::size_t h = 0; h < half_edge_count; h++) {
+
+            half_edge_offsets[indices[h] + 1]++;
+
+        }
+        for (std::size_t v = 0; v < points.size(); v++) {
+
+            half_edge_offsets[v + 1] += half_edge_offsets[v];
+
+        }
+        {
+
+            std::vector<std::uint32_t> positions(half_edge_offsets.begin(), half_edge_offsets.end() - 1);
+            for (std::uint32_t h = 0; h < half_edge_count; h++) {
+
+                half_edges_by_origin[positions[indices[h]]++] = h;
+
+            }
+
+        }
+
+        workers.parallel_for(half_edge_count, [&] (std::size_t begin, std::size_t end) {
+
+            for (std::size_t h = begin; h < end; h++) {
+
+                std::uint32_t
+                    origin = indices[h],
+                    destination = indices[next(h)];
+
+                for (std::uint32_t i = half_edge_offsets[destination]; i < half_edge_offsets[destination + 1]; i++) {
+
+                    if (indices[next(half_edges_by_origin[i])] == origin) {
+
+                        twins[h] = half_edges_by_origin[i];
+                        break;
+
+                    }
+
+                }
+
+            }
+
+        });
+
+        // Triangles to check in the current round, and the claims of the candidate edges on their neighbourhoods.
+        std::vector<std::uint32_t> dirty_triangles(triangle_count);
+        std::vector<std::uint8_t> is_dirty(triangle_count, 1);
+        std::vector<std::atomic<std::uint32_t>> claims(triangle_count);
+        constexpr std::uint32_t no_claim = 0xFFFFFFFF;
+
+        for (std::uint32_t t = 0; t < triangle_count; t++) {
+
+            dirty_triangles[t] = t;
+            claims[t].store(no_claim, std::memory_order_relaxed);
+
+        }
+
+        while (!dirty_triangles.empty()) {
+
+            if (max_rounds > 0 && statistics.rounds == max_rounds) {
+
+                statistics.converged = false;
+                break;
+
+            }
+
+            // Finding the non-Delaunay edges: each is taken from one side only, the other one if its triangle is also dirty.
+            std::size_t range_count = std::max<std::size_t>(1, std::min<std::size_t>(thread_count, dirty_triangles.size()));
+            std::vector<std::vector<std::uint32_t>> range_candidates(range_count);
+
+            workers.parallel_for(range_count, [&] (std::size_t range_begin, std::size_t range_end) {
+
+                for (std::size_t range = range_begin; range < range_end; range++) {
+
+                    for (std::size_t i = range * dirty_triangles.size() / range_count; i < (range + 1) * dirty_triangles.size() / range_count; i++) {
+
+                        for (std::uint32_t h = 3 * dirty_triangles[i]; h < 3 * dirty_triangles[i] + 3; h++) {
+
+                            std::uint32_t twin = twins[h];
+
+                            if (twin == no_half_edge || (is_dirty[twin / 3] && twin < h)) continue;
+
+                            glm::vec2
+                                a = points[indices[h]],
+                                b = points[indices[next(h)]],
+                                c = points[indices[previous(h)]],
+                                d = points[indices[previous(twin)]];
+
+                            // The flipped triangles adc and bcd must both be counterclockwise, which the incircle test implies up to rounding.
+                            if (EdgeFlip::is_in_circle(a, b, c, d) && orientation(glm::dvec2(a), glm::dvec2(d), glm::dvec2(c)) > 0.0 && orientation(glm::dvec2(b), glm::dvec2(c), glm::dvec2(d)) > 0.0) {
+
+                                range_candidates[range].push_back(h);
+
+                            }
+
+                        }
+
+                    }
+
+                }
+
+            });
+
+            std::vector<std::uint32_t> candidates;
+            for (auto const& range : range_candidates) {
+
+                candidates.insert(candidates.end(), range.begin(), range.end());
+
+            }
+
+            for (auto const& t : dirty_triangles) {
+
+                is_dirty[t] = 0;
+
+            }
+            dirty_triangles.clear();
+
+            if (candidates.empty()) break;
+            statistics.rounds++;
+
+            // The neighbourhood of an edge: its two triangles, then the triangles across their four outer edges.
+            std::vector<std::uint32_t> neighbourhoods(6 * candidates.size(), no_half_edge);
+
+            workers.parallel_for(candidates.size(), [&] (std::size_t begin, std::size_t end) {
+
+                for (std::size_t i = begin; i < end; i++) {
+
+                    std::uint32_t
+                        h = candidates[i],
+                        priority = get_priority(h),
+                        twin = twins[h],
+                        outer_edges[4] = {twins[next(h)], twins[previous(h)], twins[next(twin)], twins[previous(twin)]};
+                    std::uint32_t* neighbourhood = &neighbourhoods[6 * i];
+
+                    neighbourhood[0] = h / 3;
+                    neighbourhood[1] = twin / 3;
+                    for (std::size_t k = 0; k < 4; k++) {
+
+                        if (outer_edges[k] != no_half_edge) neighbourhood[2 + k] = outer_edges[k] / 3;
+
+                    }
+
+                    for (std::size_t k = 0; k < 6; k++) {
+
+                        if (neighbourhood[k] == no_half_edge) continue;
+
+                        std::uint32_t claim = claims[neighbourhood[k]].load(std::memory_order_relaxed);
+                        while (priority < claim && !claims[neighbourhood[k]].compare_exchange_weak(claim, priority, std::memory_order_relaxed));
+
+                    }
+
+                }
+
+            });
+
+            // Flipping the edges that won every claim: no two of them write to the same triangle.
+            std::vector<std::uint8_t> flipped(candidates.size(), 0);
+
+            workers.parallel_for(candidates.size(), [&] (std::size_t begin, std::size_t end) {
+
+                for (std::size_t i = begin; i < end; i++) {
+
+                    std::uint32_t h = candidates[i];
+                    std::uint32_t const* neighbourhood = &neighbourhoods[6 * i];
+                    bool won = true;
+
+                    for (std::size_t k = 0; k < 6 && won; k++) {
+
+                        won = neighbourhood[k] == no_half_edge || claims[neighbourhood[k]].load(std::memory_order_relaxed) == get_priority(h);
+                        // Degenerate input where the two triangles share more than one edge cannot be flipped.
+                        if (k >= 2 && (neighbourhood[k] == neighbourhood[0] || neighbourhood[k] == neighbourhood[1])) won = false;
+
+                    }
+
+                    if (!won) continue;
+
+                    // Triangles abc (edge ab) and bad (edge ba) become adc and bcd, in the same slots.
+                    std::uint32_t
+                        twin = twins[h],
+                        t = h / 3,
+                        u = twin / 3,
+                        a = indices[h],
+                        b = indices[next(h)],
+                        c = indices[previous(h)],
+                        d = indices[previous(twin)],
+                        outer_ad = twins[next(twin)],
+                        outer_ca = twins[previous(h)],
+                        outer_bc = twins[next(h)],
+                        outer_db = twins[previous(twin)];
+
+                    indices[3*t] = a;
+                    indices[3*t + 1] = d;
+                    indices[3*t + 2] = c;
+                    indices[3*u] = b;
+                    indices[3*u + 1] = c;
+                    indices[3*u + 2] = d;
+
+                    twins[3*t] = outer_ad;
+                    twins[3*t + 1] = 3*u + 1;
+                    twins[3*t + 2] = outer_ca;
+                    twins[3*u] = outer_bc;
+                    twins[3*u + 1] = 3*t + 1;
+                    twins[3*u + 2] = outer_db;
+
+                    if (outer_ad != no_half_edge) twins[outer_ad] = 3*t;
+                    if (outer_ca != no_half_edge) twins[outer_ca] = 3*t + 2;
+                    if (outer_bc != no_half_edge) twins[outer_bc] = 3*u;
+                    if (outer_db != no_half_edge) twins[outer_db] = 3*u + 2;
+
+                    flipped[i] = 1;
+
+                }
+
+            });
+
+            // Releasing the claims, and checking in the next round the flipped triangles and those of the edges left for later.
+            for (std::size_t i = 0; i < candidates.size(); i++) {
+
+                for (std::size_t k = 0; k < 6; k++) {
+
+                    if (neighbourhoods[6*i + k] != no_half_edge) claims[neighbourhoods[6*i + k]].store(no_claim, std::memory_order_relaxed);
+
+                }
+
+                for (std::size_t k = 0; k < 2; k++) {
+
+                    if (!is_dirty[neighbourhoods[6*i + k]]) {
+
+                        is_dirty[neighbourhoods[6*i + k]] = 1;
+                        dirty_triangles.push_back(neighbourhoods[6*i + k]);
+
+                    }
+
+                }
+
+                statistics.flips += flipped[i];
+
+            }
+
+        }
+
+        return statistics;
+
+    }
+
+}
@@ -0,0 +1,48 @@
+#ifndef TRIANGULATION_EDGEFLIP_HPP
+#define TRIANGULATION_EDGEFLIP_HPP
+
+#include <vector>
+#include <cstdint>
+#include <glm/vec2.hpp>
+
+namespace triangulation {
+
+    // Lawson edge-flip pass: turns any triangulation of a point set into a Delaunay triangulation by flipping every edge
+    // whose opposite vertex lies inside the circumcircle of its other triangle, until none is left.
+    // Meant for triangulations that are not Delaunay, or whose points moved afterwards (quantized with CompactPoints, snapped, ...).
+    // SweepHull output is Delaunay already, and so is AdvancingFront output for points in general position; with points on the
+    // convex hull edges (grids, ...) AdvancingFront leaves them out, which flipping cannot repair.
+    class EdgeFlip {
+
+        public:
+
+            struct Statistics {
+
+                std::size_t flips = 0;
+                std::size_t rounds = 0;
+                // False when max_rounds was reached before every edge was Delaunay.
+                bool converged = true;
+
+            };
+
+        private:
+
+            static constexpr std::uint32_t no_half_edge = 0xFFFFFFFF;
+
+            // Returns true if d lies strictly inside the circumcircle of the counterclockwise triangle abc, beyond the rounding error.
+            static bool is_in_circle (glm::vec2 a, glm::vec2 b, glm::vec2 c, glm::vec2 d);
+
+        public:
+
+            // Flips the edges of the triangles in place; every triangle ends up counterclockwise.
+            // Each round finds the non-Delaunay edges among the triangles changed by the previous round, then flips at once a set of them
+            // whose quadrilaterals and neighbours are disjoint: each edge claims its two triangles and their neighbours (the edge of highest
+            // scrambled priority wins) and the edges that won all their claims are flipped by thread_count threads (0 uses every hardware thread).
+            // The others are retried in the next round. max_rounds = 0 runs until convergence.
+            static Statistics make_delaunay (std::vector<glm::vec2> const& points, std::vector<std::uint32_t>& indices, unsigned int thread_count = 0, std::size_t max_rounds = 0);
+
+    };
+
+}
+
+#endif
@@ -0,0 +1,181 @@
+#include "ObjFile.hpp"
+#include <stdexcept>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <limits>
+#include <glm/glm.hpp>
+
+namespace triangulation {
+
+    std::vector<std::vector<glm::vec2>> ObjFile::read (std::string const& file_name) {
+
+        std::vector<VertexAttributes> group_attributes;
+        return ObjFile::read(file_name, group_attributes);
+
+    }
+
+    std::vector<std::vector<glm::vec2>> ObjFile::read (std::string const& file_name, std::vector<VertexAttributes>& group_attributes) {
+
+        std::ifstream file(file_name);
+        if (!file) {
+
+            throw std::invalid_argument("Failed to open file: " + file_name + "\n");
+
+        }
+
+        std::vector<std::vector<glm::vec2>> groups;
+        int current_group = -1;
+        std::string line;
+        std::vector<float> values;
+        std::size_t channel_count = 0;
+
+        group_attributes.clear();
+
+        while (std::getline(file, line)) {
+
+            std::istringstream ss(line);
+            std::string prefix;
+            ss >> prefix;
+
+            if (prefix == "v") {
+
+                if (current_group == -1) {
+
+                    groups.push_back(std::vector<glm::vec2>());
+                    group_attributes.push_back(VertexAttributes());
+                    ++current_group;
+
+                }
+
+                float x, y, value;
+                ss >> x >> y;
+
+                values.clear();
+                while (ss >> value) {
+
+                    values.push_back(value);
+
+                }
+
+                // Channels appear as longer vertex lines do, with 0 for the vertices read before.
+                VertexAttributes& attributes = group_attributes[current_group];
+                channel_count = std::max(channel_count, values.size());
+                attributes.channels.resize(channel_count, std::vector<float>(groups[current_group].size(), 0.0f));
+                for (std::size_t c = 0; c < channel_count; c++) {
+
+                    attributes.channels[c].push_back(c < values.size() ? values[c] : 0.0f);
+
+                }
+
+                groups[current_group].emplace_back(x, y);
+
+            } else if (prefix == "g") {
+
+                groups.push_back(std::vector<glm::vec2>());
+                group_attributes.push_back(VertexAttributes());
+                ++current_group;
+
+            }
+
+        }
+
+        // Giving every group all the channels.
+        for (std::size_t g = 0; g < groups.size(); g++) {
+
+            VertexAttributes& attributes = group_attributes[g];
+
+            attributes.channels.resize(channel_count, std::vector<float>(groups[g].size(), 0.0f));
+            for (std::size_t c = 0; c < channel_count; c++) {
+
+                attributes.names.push_back((c == 0) ? "z" : "value_" + std::to_string(c + 3));
+
+            }
+
+        }
+
+        return groups;
+
+    }
+
+    CompactPoints ObjFile::read_compact (std::string const& file_name, unsigned int bits) {
+
+        std::ifstream file(file_name);
+        if (!file) {
+
+            throw std::invalid_argument("Failed to open file: " + file_name + "\n");
+
+        }
+
+        std::string line;
+        std::size_t count = 0;
+        glm::vec2 min_corner(0.0f), max_corner(0.0f);
+
+        auto read_vertex = [&line] (glm::vec2& point) {
+
+            std::istringstream ss(line);
+            std::string prefix;
+
+            ss >> prefix;
+            if (prefix != "v") return false;
+            ss >> point.x >> point.y;
+            return true;
+
+        };
+
+        for (glm::vec2 point; std::getline(file, line);) {
+
+            if (!read_vertex(point)) continue;
+            min_corner = (count == 0) ? point : glm::min(min_corner, point);
+            max_corner = (count == 0) ? point : glm::max(max_corner, point);
+            count++;
+
+        }
+
+        CompactPoints points(min_corner, max_corner, bits);
+
+        file.clear();
+        file.seekg(0);
+        points.reserve(count);
+        for (glm::vec2 point; std::getline(file, line);) {
+
+            if (read_vertex(point)) points.push_back(point);
+
+        }
+
+        return points;
+
+    }
+
+    void ObjFile::write (std::string const& file_name, std::vector<glm::vec2> const& points, std::vector<std::uint32_t> const& indices, VertexAttributes const& attributes) {
+
+        if (attributes.get_channel_count() > 0 && attributes.get_vertex_count() != points.size()) throw std::invalid_argument("Error: Attributes do not match the points!");
+
+        std::ofstream file(file_name, std::ios::trunc);
+
+        // Enough digits for every float to read back exactly; the default 6 would move the points.
+        file << std::setprecision(std::numeric_limits<float>::max_digits10);
+
+        for (std::size_t i = 0; i < points.size(); i++) {
+
+            file << "v " << points[i].x << " " << points[i].y;
+            for (auto const& channel : attributes.channels) {
+
+                file << " " << channel[i];
+
+            }
+            file << (attributes.get_channel_count() > 0 ? "\n" : " 0\n");
+
+        }
+        for (std::size_t i = 0; i + 2 < indices.size(); i += 3) {
+
+            file << "f " << indices[i] + 1 << " " << indices[i + 1] + 1 << " " << indices[i + 2] + 1 << "\n";
+
+        }
+
+        if (!file) throw std::runtime_error("Error: Failed to write file " + file_name + "!");
+
+    }
+
+}
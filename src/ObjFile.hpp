@@ -0,0 +1,37 @@
+#ifndef TRIANGULATION_OBJFILE_HPP
+#define TRIANGULATION_OBJFILE_HPP
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <glm/vec2.hpp>
+#include "VertexAttributes.hpp"
+#include "CompactPoints.hpp"
+
+namespace triangulation {
+
+    // Wavefront OBJ input and output of 2D point sets and triangulations, with z and any further vertex values as attributes.
+    class ObjFile {
+
+        public:
+
+            // Each "g" line starts a new group of points; vertices before the first one form their own group.
+            static std::vector<std::vector<glm::vec2>> read (std::string const& file_name);
+
+            // Same, also keeping the values after x and y on each vertex line as attribute channels of its group: "z", then
+            // "value_4", "value_5"... by column. Every group gets the channels of the longest vertex line, missing values being 0.
+            static std::vector<std::vector<glm::vec2>> read (std::string const& file_name, std::vector<VertexAttributes>& group_attributes);
+
+            // Reads the vertices of every group, in order, straight into quantized storage: a first pass over the file finds their
+            // bounding box and a second one quantizes them, so they are never all held as glm::vec2.
+            static CompactPoints read_compact (std::string const& file_name, unsigned int bits);
+
+            // Writes the points as vertices and the triangles as faces (1-based indices). The channels of the attributes, if any,
+            // follow x and y on each vertex line in their order, otherwise z is written as 0.
+            static void write (std::string const& file_name, std::vector<glm::vec2> const& points, std::vector<std::uint32_t> const& indices, VertexAttributes const& attributes = {});
+
+    };
+
+}
+
+#endif
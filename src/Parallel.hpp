@@ -0,0 +1,166 @@
+#ifndef TRIANGULATION_PARALLEL_HPP
+#define TRIANGULATION_PARALLEL_HPP
+
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+namespace triangulation {
+
+    // Number of threads to use when 0 (automatic) is requested.
+    inline unsigned int get_thread_count (unsigned int thread_count) {
+
+        return (thread_count > 0) ? thread_count : std::max(1u, std::thread::hardware_concurrency());
+
+    }
+
+    // Runs function(begin, end) over thread_count contiguous ranges of [0, count) (0 uses every hardware thread), the first one on the calling thread.
+    template <typename Function>
+    void parallel_for (std::size_t count, unsigned int thread_count, Function function) {
+
+        std::vector<std::thread> threads;
+
+        if (count == 0) return;
+
+        thread_count = triangulation::get_thread_count(thread_count);
+        std::size_t chunk_size = (count + thread_count - 1) / thread_count;
+
+        for (std::size_t begin = chunk_size; begin < count; begin += chunk_size) {
+
+            threads.emplace_back(function, begin, std::min(begin + chunk_size, count));
+
+        }
+        function(0, std::min(chunk_size, count));
+
+        for (auto& thread : threads) {
+
+            thread.join();
+
+        }
+
+    }
+
+    // Threads kept for several parallel loops, so that many short loops (the rounds of EdgeFlip) do not create and join threads each time.
+    // Loops run one at a time, from the thread that created the pool.
+    class WorkerPool {
+
+        private:
+
+            std::vector<std::thread> threads;
+            std::mutex mutex;
+            std::condition_variable work_ready, work_done;
+            // Runs the range of the given thread in the current loop.
+            std::function<void(std::size_t)> task;
+            std::size_t generation, pending;
+            bool stopping;
+
+            void run_worker (std::size_t index) {
+
+                std::size_t seen_generation = 0;
+
+                while (true) {
+
+                    {
+
+                        std::unique_lock<std::mutex> lock(this->mutex);
+                        this->work_ready.wait(lock, [&] { return this->stopping || this->generation != seen_generation; });
+                        if (this->stopping) return;
+                        seen_generation = this->generation;
+
+                    }
+
+                    this->task(index);
+
+                    std::lock_guard<std::mutex> lock(this->mutex);
+                    if (--this->pending == 0) this->work_done.notify_one();
+
+                }
+
+            }
+
+        public:
+
+            // Starts thread_count - 1 threads (0 uses every hardware thread), the calling thread taking the first range of each loop.
+            WorkerPool (unsigned int thread_count) : generation(0), pending(0), stopping(false) {
+
+                thread_count = triangulation::get_thread_count(thread_count);
+                for (std::size_t index = 1; index < thread_count; index++) {
+
+                    this->threads.emplace_back(&WorkerPool::run_worker, this, index);
+
+                }
+
+            }
+
+            ~WorkerPool () {
+
+                {
+
+                    std::lock_guard<std::mutex> lock(this->mutex);
+                    this->stopping = true;
+
+                }
+                this->work_ready.notify_all();
+
+                for (auto& thread : this->threads) {
+
+                    thread.join();
+
+                }
+
+            }
+
+            WorkerPool (WorkerPool const&) = delete;
+            WorkerPool& operator = (WorkerPool const&) = delete;
+
+            unsigned int get_thread_count () const {
+
+                return static_cast<unsigned int>(this->threads.size() + 1);
+
+            }
+
+            // Same as the parallel_for function, over the threads of the pool.
+            template <typename Function>
+            void parallel_for (std::size_t count, Function function) {
+
+                std::size_t chunk_size = (count + this->get_thread_count() - 1) / this->get_thread_count();
+
+                if (count == 0) return;
+                if (this->threads.empty() || chunk_size == count) {
+
+                    function(0, count);
+                    return;
+
+                }
+
+                this->task = [&function, chunk_size, count] (std::size_t index) {
+
+                    std::size_t begin = index * chunk_size;
+                    if (begin < count) function(begin, std::min(begin + chunk_size, count));
+
+                };
+
+                {
+
+                    std::lock_guard<std::mutex> lock(this->mutex);
+                    this->pending = this->threads.size();
+                    this->generation++;
+
+                }
+                this->work_ready.notify_all();
+
+                this->task(0);
+
+                std::unique_lock<std::mutex> lock(this->mutex);
+                this->work_done.wait(lock, [this] { return this->pending == 0; });
+
+            }
+
+    };
+
+}
+
+#endif
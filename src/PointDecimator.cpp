@@ -0,0 +1,151 @@
+#include "PointDecimator.hpp"
+#include "Parallel.hpp"
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <glm/glm.hpp>
+
+namespace triangulation {
+
+    PointDecimator::Result PointDecimator::decimate (std::vector<glm::vec2> const& points, std::size_t resolution, unsigned int thread_count) {
+
+        if (resolution == 0) throw std::invalid_argument("Error: Decimation resolution must be positive!");
+
+        Result result;
+        constexpr std::uint32_t no_point = std::numeric_limits<std::uint32_t>::max();
+
+        if (points.empty()) return result;
+
+        thread_count = get_thread_count(thread_count);
+
+        std::size_t range_count = std::max<std::size_t>(1, std::min<std::size_t>(thread_count, points.size()));
+        std::vector<glm::vec2>
+            range_min(range_count, glm::vec2(std::numeric_limits<float>::max())),
+            range_max(range_count, glm::vec2(-std::numeric_limits<float>::max()));
+        auto range_begin = [&points, range_count] (std::size_t range) { return range * points.size() / range_count; };
+
+        parallel_for(range_count, range_count, [&] (std::size_t first_range, std::size_t last_range) {
+
+            for (std::size_t range = first_range; range < last_range; range++) {
+
+                for (std::size_t i = range_begin(range); i < range_begin(range + 1); i++) {
+
+                    range_min[range] = glm::min(range_min[range], points[i]);
+                    range_max[range] = glm::max(range_max[range], points[i]);
+
+                }
+
+            }
+
+        });
+
+        glm::vec2 min_corner = range_min[0], max_corner = range_max[0];
+        for (std::size_t range = 1; range < range_count; range++) {
+
+            min_corner = glm::min(min_corner, range_min[range]);
+            max_corner = glm::max(max_corner, range_max[range]);
+
+        }
+
+        double cell_size = std::max<double>(std::max(max_corner.x - min_corner.x, max_corner.y - min_corner.y) / resolution, std::numeric_limits<float>::min());
+        std::size_t
+            columns = std::min<std::size_t>(resolution, static_cast<std::size_t>((max_corner.x - min_corner.x) / cell_size) + 1),
+            rows = std::min<std::size_t>(resolution, static_cast<std::size_t>((max_corner.y - min_corner.y) / cell_size) + 1),
+            cell_count = columns * rows;
+
+        auto get_cell = [&] (glm::vec2 point) {
+
+            std::size_t
+                column = std::min<std::size_t>(columns - 1, static_cast<std::size_t>((point.x - min_corner.x) / cell_size)),
+                row = std::min<std::size_t>(rows - 1, static_cast<std::size_t>((point.y - min_corner.y) / cell_size));
+            return row * columns + column;
+
+        };
+        auto get_distance = [&] (std::uint32_t index, std::size_t cell) {
+
+            glm::dvec2 center(min_corner.x + ((cell % columns) + 0.5) * cell_size, min_corner.y + ((cell / columns) + 0.5) * cell_size);
+            return glm::length(glm::dvec2(points[index]) - center);
+
+        };
+
+        // Each range of points picks its best point per cell, then the ranges are merged cell by cell (earlier ranges win ties).
+        std::vector<std::vector<std::uint32_t>> range_best(range_count, std::vector<std::uint32_t>(cell_count, no_point));
+
+        parallel_for(range_count, range_count, [&] (std::size_t first_range, std::size_t last_range) {
+
+            for (std::size_t range = first_range; range < last_range; range++) {
+
+                std::vector<std::uint32_t>& best = range_best[range];
+
+                for (std::size_t i = range_begin(range); i < range_begin(range + 1); i++) {
+
+                    std::size_t cell = get_cell(points[i]);
+                    if (best[cell] == no_point || get_distance(static_cast<std::uint32_t>(i), cell) < get_distance(best[cell], cell)) best[cell] = static_cast<std::uint32_t>(i);
+
+                }
+
+            }
+
+        });
+
+        std::vector<std::uint32_t>& best = range_best[0];
+        std::vector<std::uint32_t> chunk_counts(range_count, 0);
+        auto chunk_begin = [cell_count, range_count] (std::size_t chunk) { return chunk * cell_count / range_count; };
+
+        parallel_for(range_count, range_count, [&] (std::size_t first_chunk, std::size_t last_chunk) {
+
+            for (std::size_t chunk = first_chunk; chunk < last_chunk; chunk++) {
+
+                for (std::size_t cell = chunk_begin(chunk); cell < chunk_begin(chunk + 1); cell++) {
+
+                    for (std::size_t range = 1; range < range_count; range++) {
+
+                        std::uint32_t candidate = range_best[range][cell];
+                        if (candidate != no_point && (best[cell] == no_point || get_distance(candidate, cell) < get_distance(best[cell], cell))) best[cell] = candidate;
+
+                    }
+
+                    if (best[cell] != no_point) chunk_counts[chunk]++;
+
+                }
+
+            }
+
+        });
+
+        // Writing the kept points of each chunk of cells at its offset.
+        std::vector<std::size_t> chunk_offsets(range_count + 1, 0);
+        for (std::size_t chunk = 0; chunk < range_count; chunk++) {
+
+            chunk_offsets[chunk + 1] = chunk_offsets[chunk] + chunk_counts[chunk];
+
+        }
+
+        result.points.resize(chunk_offsets.back());
+        result.source_indices.resize(chunk_offsets.back());
+
+        parallel_for(range_count, range_count, [&] (std::size_t first_chunk, std::size_t last_chunk) {
+
+            for (std::size_t chunk = first_chunk; chunk < last_chunk; chunk++) {
+
+                std::size_t offset = chunk_offsets[chunk];
+
+                for (std::size_t cell = chunk_begin(chunk); cell < chunk_begin(chunk + 1); cell++) {
+
+                    if (best[cell] == no_point) continue;
+
+                    result.points[offset] = points[best[cell]];
+                    result.source_indices[offset] = best[cell];
+                    offset++;
+
+                }
+
+            }
+
+        });
+
+        return result;
+
+    }
+
+}
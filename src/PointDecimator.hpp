@@ -0,0 +1,33 @@
+#ifndef TRIANGULATION_POINTDECIMATOR_HPP
+#define TRIANGULATION_POINTDECIMATOR_HPP
+
+#include <vector>
+#include <cstdint>
+#include <glm/vec2.hpp>
+
+namespace triangulation {
+
+    // Grid-clustering decimation: keeps one representative point per cell of a uniform grid, for quick previews of large point sets.
+    class PointDecimator {
+
+        public:
+
+            struct Result {
+
+                // Kept points, in row-major cell order.
+                std::vector<glm::vec2> points;
+                // Index in the input of each kept point.
+                std::vector<std::uint32_t> source_indices;
+
+            };
+
+            // Clusters the points into square cells, resolution of them along the longer side of the bounding box, and keeps in each
+            // non-empty cell the point closest to its centre (the first one on ties). The work is split between thread_count threads
+            // (0 uses every hardware thread), each of which needs 4 bytes per cell.
+            static Result decimate (std::vector<glm::vec2> const& points, std::size_t resolution, unsigned int thread_count = 0);
+
+    };
+
+}
+
+#endif
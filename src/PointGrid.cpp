@@ -0,0 +1,124 @@
+#include "PointGrid.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <glm/glm.hpp>
+
+namespace triangulation {
+
+    PointGrid::PointGrid (std::vector<glm::vec2> const& _points) : points(_points), origin(0.0f), cell_size(1.0f), columns(1), rows(1) {
+
+        glm::vec2 max_corner(-std::numeric_limits<float>::max());
+
+        this->origin = glm::vec2(std::numeric_limits<float>::max());
+        for (auto const& point : this->points) {
+
+            this->origin = glm::min(this->origin, point);
+            max_corner = glm::max(max_corner, point);
+
+        }
+
+        if (!this->points.empty()) {
+
+            glm::vec2 extent = max_corner - this->origin;
+
+            // About one point per cell.
+            this->cell_size = std::max(std::sqrt(std::max(extent.x, 1e-6f) * std::max(extent.y, 1e-6f) / this->points.size()), 1e-6f);
+            this->columns = std::min<std::size_t>(static_cast<std::size_t>(extent.x / this->cell_size) + 1, 1 << 16);
+            this->rows = std::min<std::size_t>(static_cast<std::size_t>(extent.y / this->cell_size) + 1, 1 << 16);
+
+        }
+
+        // Counting sort of the points by cell.
+        this->cell_starts.assign(this->columns * this->rows + 1, 0);
+        for (auto const& point : this->points) {
+
+            this->cell_starts[this->get_row(point.y) * this->columns + this->get_column(point.x) + 1]++;
+
+        }
+        for (std::size_t i = 1; i < this->cell_starts.size(); i++) {
+
+            this->cell_starts[i] += this->cell_starts[i - 1];
+
+        }
+
+        std::vector<std::uint32_t> offsets(this->cell_starts.begin(), this->cell_starts.end() - 1);
+        this->cell_points.resize(this->points.size());
+        for (std::uint32_t i = 0; i < this->points.size(); i++) {
+
+            this->cell_points[offsets[this->get_row(this->points[i].y) * this->columns + this->get_column(this->points[i].x)]++] = i;
+
+        }
+
+    }
+
+    std::size_t PointGrid::get_column (float x) const {
+
+        return static_cast<std::size_t>(std::clamp((x - this->origin.x) / this->cell_size, 0.0f, static_cast<float>(this->columns - 1)));
+
+    }
+
+    std::size_t PointGrid::get_row (float y) const {
+
+        return static_cast<std::size_t>(std::clamp((y - this->origin.y) / this->cell_size, 0.0f, static_cast<float>(this->rows - 1)));
+
+    }
+
+    bool PointGrid::compute_circumcircle (glm::vec2 const (&vertices)[3], glm::dvec2& center, double& radius) {
+
+        glm::dvec2
+            a(vertices[0]),
+            b = glm::dvec2(vertices[1]) - a,
+            c = glm::dvec2(vertices[2]) - a;
+        double d = 2.0 * (b.x * c.y - b.y * c.x);
+
+        if (d == 0.0) return false;
+
+        center = a + glm::dvec2(c.y * (b.x*b.x + b.y*b.y) - b.y * (c.x*c.x + c.y*c.y), b.x * (c.x*c.x + c.y*c.y) - c.x * (b.x*b.x + b.y*b.y)) / d;
+        radius = glm::length(center - a);
+
+        return true;
+
+    }
+
+    bool PointGrid::is_circle_empty (glm::dvec2 center, double radius, glm::vec2 const (&vertices)[3], bool allow_cocircular) const {
+
+        // Tolerance relative to the radius, so cocircular points count as outside, or as inside when they are not allowed.
+        double limit = radius * radius * (allow_cocircular ? 1.0 - 1e-9 : 1.0 + 1e-9);
+
+        double reach = std::sqrt(limit);
+
+        for (std::size_t row = this->get_row(center.y - reach); row <= this->get_row(center.y + reach); row++) {
+
+            for (std::size_t column = this->get_column(center.x - reach); column <= this->get_column(center.x + reach); column++) {
+
+                std::size_t cell = row * this->columns + column;
+
+                for (std::uint32_t i = this->cell_starts[cell]; i < this->cell_starts[cell + 1]; i++) {
+
+                    glm::vec2 point = this->points[this->cell_points[i]];
+                    glm::dvec2 offset = glm::dvec2(point) - center;
+
+                    if (point == vertices[0] || point == vertices[1] || point == vertices[2]) continue;
+                    if (offset.x*offset.x + offset.y*offset.y < limit) return false;
+
+                }
+
+            }
+
+        }
+
+        return true;
+
+    }
+
+    bool PointGrid::is_delaunay (glm::vec2 const (&vertices)[3]) const {
+
+        glm::dvec2 center;
+        double radius;
+
+        return PointGrid::compute_circumcircle(vertices, center, radius) && this->is_circle_empty(center, radius, vertices);
+
+    }
+
+}
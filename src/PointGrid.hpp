@@ -0,0 +1,45 @@
+#ifndef TRIANGULATION_POINTGRID_HPP
+#define TRIANGULATION_POINTGRID_HPP
+
+#include <vector>
+#include <cstdint>
+#include <glm/vec2.hpp>
+
+namespace triangulation {
+
+    // Uniform grid with about one point per cell, used to check that circumcircles are empty (the Delaunay condition).
+    // The grid refers to the points, which must outlive it.
+    class PointGrid {
+
+        private:
+
+            std::vector<glm::vec2> const& points;
+            glm::vec2 origin;
+            float cell_size;
+            std::size_t columns, rows;
+            std::vector<std::uint32_t> cell_starts;
+            std::vector<std::uint32_t> cell_points;
+
+            std::size_t get_column (float x) const;
+            std::size_t get_row (float y) const;
+
+        public:
+
+            PointGrid (std::vector<glm::vec2> const& points);
+
+            // Returns false for degenerate triangles.
+            static bool compute_circumcircle (glm::vec2 const (&vertices)[3], glm::dvec2& center, double& radius);
+
+            // Returns true if no point lies strictly inside the circle, other than points at the triangle vertices. Without
+            // allow_cocircular, points on the circle (within a tolerance relative to the radius) do not leave it empty either:
+            // such triangles belong to every Delaunay triangulation of the points, while cocircular ones may be swapped.
+            bool is_circle_empty (glm::dvec2 center, double radius, glm::vec2 const (&vertices)[3], bool allow_cocircular = true) const;
+
+            // Returns true if the triangle is not degenerate and its circumcircle is empty.
+            bool is_delaunay (glm::vec2 const (&vertices)[3]) const;
+
+    };
+
+}
+
+#endif
@@ -0,0 +1,267 @@
+#include "PointLocation.hpp"
+#include "SpatialSort.hpp"
+#include "Parallel.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace triangulation {
+
+    namespace {
+
+        // Twice the signed area of the triangle (a, b, c), positive when counterclockwise.
+        double orientation (glm::vec2 a, glm::vec2 b, glm::vec2 c) {
+
+            return (static_cast<double>(b.x) - a.x) * (static_cast<double>(c.y) - a.y) - (static_cast<double>(b.y) - a.y) * (static_cast<double>(c.x) - a.x);
+
+        }
+
+        std::uint32_t next_random (std::uint32_t& state) {
+
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+            return state;
+
+        }
+
+    }
+
+    PointLocation::PointLocation () {}
+
+    PointLocation::PointLocation (std::vector<glm::vec2> const& _points, std::vector<std::uint32_t> const& _indices) {
+
+        this->build(_points, _indices);
+
+    }
+
+    void PointLocation::build (std::vector<glm::vec2> const& _points, std::vector<std::uint32_t> const& _indices) {
+
+        if (_indices.size() % 3 != 0) throw std::invalid_argument("Error: Triangle indices count is not a multiple of 3!");
+
+        this->points = _points;
+        this->indices = _indices;
+
+        std::size_t triangle_count = this->get_triangle_count();
+
+        // Matching the two sides of each edge by sorting the edges on their sorted vertex pair.
+        std::vector<std::pair<std::uint64_t, std::uint32_t>> edges(this->indices.size());
+        for (std::size_t i = 0; i < this->indices.size(); i++) {
+
+            std::uint32_t
+                v1 = this->indices[i],
+                v2 = this->indices[(i % 3 == 2) ? i - 2 : i + 1];
+
+            if (v1 >= this->points.size() || v2 >= this->points.size()) throw std::out_of_range("Error: Triangle index out of range!");
+            edges[i] = {(static_cast<std::uint64_t>(std::min(v1, v2)) << 32) | std::max(v1, v2), static_cast<std::uint32_t>(i)};
+
+        }
+        std::sort(edges.begin(), edges.end());
+
+        this->neighbors.assign(this->indices.size(), no_triangle);
+        for (std::size_t i = 0; i + 1 < edges.size(); i++) {
+
+            if (edges[i].first != edges[i + 1].first) continue;
+
+            this->neighbors[edges[i].second] = edges[i + 1].second / 3;
+            this->neighbors[edges[i + 1].second] = edges[i].second / 3;
+            i++;
+
+        }
+
+        // Taking about cbrt(n) samples evenly along the Hilbert order of the centroids spreads them over the whole triangulation.
+        std::vector<glm::vec2> centroids(triangle_count);
+        for (std::size_t t = 0; t < triangle_count; t++) {
+
+            centroids[t] = this->compute_centroid(t);
+
+        }
+
+        std::vector<std::uint32_t> order = SpatialSort::compute_order(centroids);
+        std::size_t sample_count = std::max<std::size_t>(1, std::llround(std::cbrt(static_cast<double>(triangle_count))));
+
+        this->samples.clear();
+        this->sample_centroids.clear();
+        for (std::size_t i = 0; i < triangle_count; i += (triangle_count + sample_count - 1) / sample_count) {
+
+            this->samples.push_back(order[i]);
+            this->sample_centroids.push_back(centroids[order[i]]);
+
+        }
+
+    }
+
+    std::size_t PointLocation::get_triangle_count () const {
+
+        return this->indices.size() / 3;
+
+    }
+
+    glm::vec2 PointLocation::compute_centroid (std::uint32_t triangle) const {
+
+        return (this->points[this->indices[3*triangle]] + this->points[this->indices[3*triangle + 1]] + this->points[this->indices[3*triangle + 2]]) / 3.0f;
+
+    }
+
+    bool PointLocation::contains (std::uint32_t triangle, glm::vec2 point) const {
+
+        glm::vec2
+            a = this->points[this->indices[3*triangle]],
+            b = this->points[this->indices[3*triangle + 1]],
+            c = this->points[this->indices[3*triangle + 2]];
+        double area = orientation(a, b, c);
+
+        if (area == 0.0) return false;
+
+        // Points on an edge belong to the triangle.
+        return orientation(a, b, point) * area >= 0.0 && orientation(b, c, point) * area >= 0.0 && orientation(c, a, point) * area >= 0.0;
+
+    }
+
+    std::uint32_t PointLocation::find_seed (glm::vec2 point, std::uint32_t hint) const {
+
+        std::uint32_t seed = no_triangle;
+        float min_distance = std::numeric_limits<float>::max();
+
+        if (hint != no_triangle) {
+
+            glm::vec2 offset = this->compute_centroid(hint) - point;
+            seed = hint;
+            min_distance = offset.x*offset.x + offset.y*offset.y;
+
+        }
+
+        for (std::size_t i = 0; i < this->samples.size(); i++) {
+
+            glm::vec2 offset = this->sample_centroids[i] - point;
+            float distance = offset.x*offset.x + offset.y*offset.y;
+
+            if (distance < min_distance) {
+
+                min_distance = distance;
+                seed = this->samples[i];
+
+            }
+
+        }
+
+        return seed;
+
+    }
+
+    std::uint32_t PointLocation::walk (std::uint32_t start, glm::vec2 point, std::uint32_t& random_state) const {
+
+        std::uint32_t triangle = start;
+
+        // A walk longer than the triangle count means degenerate triangles trapped it.
+        for (std::size_t step = 0; step <= this->get_triangle_count(); step++) {
+
+            glm::vec2 vertices[3] = {
+                this->points[this->indices[3*triangle]],
+                this->points[this->indices[3*triangle + 1]],
+                this->points[this->indices[3*triangle + 2]]
+            };
+            double area = orientation(vertices[0], vertices[1], vertices[2]);
+            std::uint32_t first_edge = next_random(random_state) % 3;
+            bool crossed = false;
+
+            for (std::uint32_t k = 0; k < 3; k++) {
+
+                std::uint32_t edge = (first_edge + k) % 3;
+
+                // The point is across this edge when it lies on the other side than the opposite vertex.
+                if (area != 0.0 && orientation(vertices[edge], vertices[(edge + 1) % 3], point) * area >= 0.0) continue;
+
+                if (this->neighbors[3*triangle + edge] == no_triangle) {
+
+                    if (area != 0.0) return no_triangle;
+                    continue;
+
+                }
+
+                triangle = this->neighbors[3*triangle + edge];
+                crossed = true;
+                break;
+
+            }
+
+            if (!crossed) return (area != 0.0) ? triangle : this->scan(point);
+
+        }
+
+        return this->scan(point);
+
+    }
+
+    std::uint32_t PointLocation::scan (glm::vec2 point) const {
+
+        for (std::uint32_t t = 0; t < this->get_triangle_count(); t++) {
+
+            if (this->contains(t, point)) return t;
+
+        }
+
+        return no_triangle;
+
+    }
+
+    std::uint32_t PointLocation::locate (glm::vec2 point, std::uint32_t hint) const {
+
+        std::uint32_t random_state = 0x9E3779B9u;
+
+        if (this->indices.empty()) return no_triangle;
+        if (hint != no_triangle && hint < this->get_triangle_count() && this->contains(hint, point)) return hint;
+
+        return this->walk(this->find_seed(point, (hint < this->get_triangle_count()) ? hint : no_triangle), point, random_state);
+
+    }
+
+    std::vector<std::uint32_t> PointLocation::locate (std::vector<glm::vec2> const& queries, unsigned int thread_count) const {
+
+        std::vector<std::uint32_t> triangles(queries.size(), no_triangle);
+
+        if (queries.empty() || this->indices.empty()) return triangles;
+
+        std::vector<std::uint32_t> order = SpatialSort::compute_order(queries);
+
+        // Each thread answers a contiguous range of the sorted queries, walking from one answer to the next.
+        auto locate_range = [&] (std::size_t begin, std::size_t end) {
+
+            std::uint32_t hint = no_triangle;
+
+            for (std::size_t i = begin; i < end; i++) {
+
+                std::uint32_t triangle = this->locate(queries[order[i]], hint);
+
+                triangles[order[i]] = triangle;
+                if (triangle != no_triangle) hint = triangle;
+
+            }
+
+        };
+
+        triangulation::parallel_for(queries.size(), thread_count, locate_range);
+
+        return triangles;
+
+    }
+
+    glm::vec3 PointLocation::compute_barycentric (std::uint32_t triangle, glm::vec2 point) const {
+
+        glm::vec2
+            a = this->points[this->indices[3*triangle]],
+            b = this->points[this->indices[3*triangle + 1]],
+            c = this->points[this->indices[3*triangle + 2]];
+        double area = orientation(a, b, c);
+
+        if (area == 0.0) return glm::vec3(1.0f, 0.0f, 0.0f);
+
+        float
+            u = static_cast<float>(orientation(b, c, point) / area),
+            v = static_cast<float>(orientation(c, a, point) / area);
+
+        return glm::vec3(u, v, 1.0f - u - v);
+
+    }
+
+}
@@ -0,0 +1,71 @@
+#ifndef TRIANGULATION_POINTLOCATION_HPP
+#define TRIANGULATION_POINTLOCATION_HPP
+
+#include <vector>
+#include <cstdint>
+#include <limits>
+#include <glm/vec2.hpp>
+#include <glm/vec3.hpp>
+
+namespace triangulation {
+
+    // Finds the triangle of a triangulation containing query points, by jump-and-walk:
+    // each query jumps to the closest of about cbrt(n) sample triangles, then walks across neighbouring triangles towards the point.
+    // The triangulation is expected to cover a convex region, as AdvancingFront's do, so a walk leaving the boundary means the point is outside.
+    class PointLocation {
+
+        public:
+
+            static constexpr std::uint32_t no_triangle = std::numeric_limits<std::uint32_t>::max();
+
+        private:
+
+            std::vector<glm::vec2> points;
+            std::vector<std::uint32_t> indices;
+
+            // neighbors[3 * t + i] is the triangle across the edge from vertex i to vertex i + 1 of triangle t, or no_triangle on the boundary.
+            std::vector<std::uint32_t> neighbors;
+
+            // Sample triangles spread along a Hilbert curve, and their centroids.
+            std::vector<std::uint32_t> samples;
+            std::vector<glm::vec2> sample_centroids;
+
+            glm::vec2 compute_centroid (std::uint32_t triangle) const;
+
+            bool contains (std::uint32_t triangle, glm::vec2 point) const;
+
+            // Returns the sample triangle whose centroid is closest to the point, or the hint if it is closer.
+            std::uint32_t find_seed (glm::vec2 point, std::uint32_t hint) const;
+
+            // Walks from the start triangle towards the point, crossing a randomly chosen separating edge at each step so the walk cannot cycle.
+            std::uint32_t walk (std::uint32_t start, glm::vec2 point, std::uint32_t& random_state) const;
+
+            // Brute force search used when a walk gets stuck on degenerate triangles.
+            std::uint32_t scan (glm::vec2 point) const;
+
+        public:
+
+            PointLocation ();
+            PointLocation (std::vector<glm::vec2> const& points, std::vector<std::uint32_t> const& indices);
+
+            // Builds the triangle adjacency and the samples, in O(n log n).
+            void build (std::vector<glm::vec2> const& points, std::vector<std::uint32_t> const& indices);
+
+            std::size_t get_triangle_count () const;
+
+            // Returns the index of the triangle containing the point (indices[3 * t] to indices[3 * t + 2]), or no_triangle.
+            // A previous result close to the point can be given as hint.
+            std::uint32_t locate (glm::vec2 point, std::uint32_t hint = no_triangle) const;
+
+            // Locates many points: the queries are sorted along a Hilbert curve so each walk starts from the previous result,
+            // and the sorted queries are split between thread_count threads (0 uses every hardware thread).
+            std::vector<std::uint32_t> locate (std::vector<glm::vec2> const& queries, unsigned int thread_count = 0) const;
+
+            // Barycentric coordinates of the point relative to the vertices of the triangle, in index order, for interpolation.
+            glm::vec3 compute_barycentric (std::uint32_t triangle, glm::vec2 point) const;
+
+    };
+
+}
+
+#endif
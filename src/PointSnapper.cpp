@@ -0,0 +1,111 @@
+#include "PointSnapper.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+
+namespace triangulation {
+
+    std::uint64_t PointSnapper::get_cell_key (std::int64_t column, std::int64_t row) {
+
+        return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(column)) << 32) | static_cast<std::uint32_t>(row);
+
+    }
+
+    PointSnapper::Result PointSnapper::snap (std::vector<glm::vec2> const& points, float tolerance) {
+
+        if (!(tolerance >= 0.0f)) throw std::invalid_argument("Error: Snapping tolerance must be positive or zero!");
+
+        Result result;
+        result.remap.resize(points.size());
+
+        if (tolerance == 0.0f) {
+
+            // Exact duplicates: the cell is the point itself (with -0 and 0 made equal).
+            std::unordered_map<std::uint64_t, std::uint32_t> first_indices;
+            first_indices.reserve(points.size());
+
+            for (std::size_t i = 0; i < points.size(); i++) {
+
+                float coordinates[2] = {points[i].x + 0.0f, points[i].y + 0.0f};
+                std::uint32_t bits[2];
+
+                std::memcpy(bits, coordinates, sizeof(bits));
+                auto inserted = first_indices.emplace((static_cast<std::uint64_t>(bits[0]) << 32) | bits[1], static_cast<std::uint32_t>(result.points.size()));
+                if (inserted.second) result.points.push_back(points[i]);
+                result.remap[i] = inserted.first->second;
+
+            }
+
+            return result;
+
+        }
+
+        // Cells as wide as the tolerance: a kept point within tolerance is in the cell of the point or in one of its 8 neighbours.
+        // Each cell lists its kept points through next_in_cell; being more than the tolerance apart, there are at most 4 of them.
+        std::unordered_map<std::uint64_t, std::uint32_t> cell_heads;
+        std::vector<std::uint32_t> next_in_cell;
+        constexpr std::uint32_t no_point = std::numeric_limits<std::uint32_t>::max();
+        double squared_tolerance = static_cast<double>(tolerance) * tolerance;
+
+        cell_heads.reserve(points.size());
+
+        for (std::size_t i = 0; i < points.size(); i++) {
+
+            glm::vec2 point = points[i];
+            std::int64_t
+                column = static_cast<std::int64_t>(std::floor(static_cast<double>(point.x) / tolerance)),
+                row = static_cast<std::int64_t>(std::floor(static_cast<double>(point.y) / tolerance));
+            std::uint32_t match = no_point;
+
+            for (std::int64_t dy = -1; dy <= 1; dy++) {
+
+                for (std::int64_t dx = -1; dx <= 1; dx++) {
+
+                    auto cell = cell_heads.find(PointSnapper::get_cell_key(column + dx, row + dy));
+                    if (cell == cell_heads.end()) continue;
+
+                    // The first kept point within tolerance, in order of appearance, wins.
+                    for (std::uint32_t k = cell->second; k != no_point; k = next_in_cell[k]) {
+
+                        double
+                            x = static_cast<double>(result.points[k].x) - point.x,
+                            y = static_cast<double>(result.points[k].y) - point.y;
+
+                        if (x * x + y * y <= squared_tolerance && k < match) match = k;
+
+                    }
+
+                }
+
+            }
+
+            if (match == no_point) {
+
+                match = static_cast<std::uint32_t>(result.points.size());
+                result.points.push_back(point);
+
+                // Appending to the cell list, so that it stays in order of appearance.
+                auto cell = cell_heads.emplace(PointSnapper::get_cell_key(column, row), match);
+                next_in_cell.push_back(no_point);
+                if (!cell.second) {
+
+                    std::uint32_t last = cell.first->second;
+                    while (next_in_cell[last] != no_point) last = next_in_cell[last];
+                    next_in_cell[last] = match;
+
+                }
+
+            }
+
+            result.remap[i] = match;
+
+        }
+
+        return result;
+
+    }
+
+}
@@ -0,0 +1,39 @@
+#ifndef TRIANGULATION_POINTSNAPPER_HPP
+#define TRIANGULATION_POINTSNAPPER_HPP
+
+#include <vector>
+#include <cstdint>
+#include <glm/vec2.hpp>
+
+namespace triangulation {
+
+    // Preprocessing stage merging duplicated and nearly duplicated points before triangulating, in expected linear time with a hash grid.
+    // Duplicates would otherwise be scanned again by every candidate search, and near-duplicates give zero-area triangles.
+    class PointSnapper {
+
+        public:
+
+            struct Result {
+
+                // The distinct points, in order of first appearance.
+                std::vector<glm::vec2> points;
+                // Index in points of each input point, so indices into the input (or into one of the groups it concatenates, shifted
+                // by the group offset) still resolve.
+                std::vector<std::uint32_t> remap;
+
+            };
+
+        private:
+
+            static std::uint64_t get_cell_key (std::int64_t column, std::int64_t row);
+
+        public:
+
+            // Each point is merged into the first kept point within tolerance of it, or kept. A tolerance of 0 only merges exact duplicates.
+            static Result snap (std::vector<glm::vec2> const& points, float tolerance = 0.0f);
+
+    };
+
+}
+
+#endif
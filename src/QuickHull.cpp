@@ -1,8 +1,8 @@
 #include "QuickHull.hpp"
 #include <algorithm>
 #include <tuple>
+#include <cmath>
 #include <glm/glm.hpp>
-#include <glm/gtx/vector_angle.hpp>
 
 namespace triangulation {
 
@@ -21,32 +21,24 @@ namespace triangulation {
         std::vector<glm::vec2> partition1, partition2, final_hull;
 
         float
-            triangle_area, angle,
+            triangle_area, projection,
             max_triangle_area = 0.0f,
-            max_angle = 0.0f;
+            min_projection = INFINITY;
 
-        // Finding the point with the maximum distance from the line.
+        // Finding the point with the maximum distance from the line. Points tied at that distance lie on a hull edge parallel
+        // to the line: taking the one with the smallest projection on the line keeps the edge end, never a collinear point.
         for (std::size_t i = 0; i < points.size(); ++i) {
 
             aux_vector = points[i] - pivot_low;
             triangle_area = glm::cross(glm::vec3(pivot_vector, 0.0f), glm::vec3(aux_vector, 0.0f)).z/2.0f;
+            projection = glm::dot(pivot_vector, aux_vector);
 
-            if (triangle_area > max_triangle_area) {
+            if (triangle_area > max_triangle_area || (triangle_area == max_triangle_area && projection < min_projection)) {
 
                 max_triangle_area = triangle_area;
+                min_projection = projection;
                 far_point = points[i];
 
-            } else if (triangle_area == max_triangle_area) {
-
-                angle = glm::angle(pivot_vector, aux_vector);
-
-                if (angle > max_angle) {
-
-                    max_angle = angle;
-                    far_point = points[i];
-
-                }
-
             }
 
         }
@@ -67,7 +59,8 @@ namespace triangulation {
 
     }
 
-    std::pair<std::vector<glm::vec2>, std::vector<glm::vec2>> QuickHull::divide (std::vector<glm::vec2> const& points, glm::vec2 const& pivot_low, glm::vec2 const& pivot_high) {
+    template <typename Points>
+    std::pair<std::vector<glm::vec2>, std::vector<glm::vec2>> QuickHull::divide (Points const& points, glm::vec2 const& pivot_low, glm::vec2 const& pivot_high) {
 
         std::pair<std::vector<glm::vec2>, std::vector<glm::vec2>> result;
         float aux;
@@ -96,44 +89,147 @@ namespace triangulation {
 
     }
 
+    template <typename Points>
+    std::vector<glm::vec2> QuickHull::compute_full_hull (Points const& points) {
+
+        if (points.size() == 0) return std::vector<glm::vec2>();
+
+        glm::vec2
+            pivot_low = points[0],
+            pivot_high = points[0];
+        std::vector<glm::vec2> left_partition, right_partition;
+        std::vector<glm::vec2> result;
+
+        // Finding the lexicographically smallest and largest points, which are hull vertices even when several points share
+        // the minimum or maximum abscissa (the others lie on a vertical hull edge and are dropped, as by merge_hulls).
+        for (std::size_t i = 1; i < points.size(); ++i) {
+
+            glm::vec2 point = points[i];
+
+            if (point.x < pivot_low.x || (point.x == pivot_low.x && point.y < pivot_low.y)) pivot_low = point;
+            if (point.x > pivot_high.x || (point.x == pivot_high.x && point.y > pivot_high.y)) pivot_high = point;
+
+        }
+
+        if (pivot_low == pivot_high) return std::vector<glm::vec2>(1, pivot_low);
+
+        std::tie(left_partition, right_partition) = QuickHull::divide(points, pivot_low, pivot_high);
+
+        left_partition = QuickHull::compute_hull(left_partition, pivot_low, pivot_high);
+        right_partition = QuickHull::compute_hull(right_partition, pivot_high, pivot_low);
+
+        // Concatenating left and right hull and initial pivot points.
+        result.reserve(left_partition.size() + right_partition.size() + 2);
+        result.push_back(pivot_low);
+        result.insert(result.end(), left_partition.begin(), left_partition.end());
+        result.push_back(pivot_high);
+        result.insert(result.end(), right_partition.begin(), right_partition.end());
+
+        return result;
+
+    }
+
     std::vector<glm::vec2> QuickHull::compute_hull (std::vector<glm::vec2> const& points) {
 
-        if (points.size() > 2) {
+        return QuickHull::compute_full_hull(points);
 
-            glm::vec2
-                pivot_low = points[0],
-                pivot_high = points[0];
-            std::vector<glm::vec2> left_partition, right_partition;
-            std::vector<glm::vec2> result;
+    }
 
-            // Finding indices of points with minimum and maximum abscissa.
-            for (std::size_t i = 1; i < points.size(); ++i) {
+    std::vector<glm::vec2> QuickHull::compute_hull (CompactPoints const& points) {
 
-                if (points[i].x < pivot_low.x) pivot_low = points[i];
-                if (points[i].x > pivot_high.x) pivot_high = points[i];
+        return QuickHull::compute_full_hull(points);
 
-            }
+    }
 
-            std::tie(left_partition, right_partition) = QuickHull::divide(points, pivot_low, pivot_high);
+    void QuickHull::split_chains (std::vector<glm::vec2> const& hull, std::vector<glm::vec2>& chain1, std::vector<glm::vec2>& chain2) {
 
-            left_partition = QuickHull::compute_hull(left_partition, pivot_low, pivot_high);
-            right_partition = QuickHull::compute_hull(right_partition, pivot_high, pivot_low);
+        if (hull.empty()) return;
 
-            // Concatenating left and right hull and initial pivot points.
-            result.reserve(left_partition.size() + right_partition.size() + 2);
-            result.push_back(pivot_low);
-            result.insert(result.end(), left_partition.begin(), left_partition.end());
-            result.push_back(pivot_high);
-            result.insert(result.end(), right_partition.begin(), right_partition.end());
+        auto is_less = [] (glm::vec2 const& a, glm::vec2 const& b) { return a.x < b.x || (a.x == b.x && a.y < b.y); };
+        std::size_t
+            size = hull.size(),
+            first = std::min_element(hull.begin(), hull.end(), is_less) - hull.begin(),
+            last = std::max_element(hull.begin(), hull.end(), is_less) - hull.begin();
 
-            return result;
+        // Both ways around a convex polygon from its smallest to its largest vertex are lexicographically sorted.
+        for (std::size_t i = first; ; i = (i + 1) % size) {
 
-        } else {
+            chain1.push_back(hull[i]);
+            if (i == last) break;
 
-            return points;
+        }
+        for (std::size_t i = first; ; i = (i + size - 1) % size) {
+
+            chain2.push_back(hull[i]);
+            if (i == last) break;
 
         }
 
     }
 
-}
\ No newline at end of file
+    std::vector<glm::vec2> QuickHull::merge_hulls (std::vector<glm::vec2> const& hull1, std::vector<glm::vec2> const& hull2) {
+
+        auto is_less = [] (glm::vec2 const& a, glm::vec2 const& b) { return a.x < b.x || (a.x == b.x && a.y < b.y); };
+        auto turn = [] (glm::vec2 const& o, glm::vec2 const& a, glm::vec2 const& b) {
+
+            return (static_cast<double>(a.x) - o.x) * (static_cast<double>(b.y) - o.y) - (static_cast<double>(a.y) - o.y) * (static_cast<double>(b.x) - o.x);
+
+        };
+
+        std::vector<glm::vec2> chain1, chain2, chain3, chain4, merged1, merged2, sorted_points, hull;
+
+        QuickHull::split_chains(hull1, chain1, chain2);
+        QuickHull::split_chains(hull2, chain3, chain4);
+
+        // Merging the four sorted chains in linear time.
+        merged1.resize(chain1.size() + chain2.size());
+        std::merge(chain1.begin(), chain1.end(), chain2.begin(), chain2.end(), merged1.begin(), is_less);
+        merged2.resize(chain3.size() + chain4.size());
+        std::merge(chain3.begin(), chain3.end(), chain4.begin(), chain4.end(), merged2.begin(), is_less);
+        sorted_points.resize(merged1.size() + merged2.size());
+        std::merge(merged1.begin(), merged1.end(), merged2.begin(), merged2.end(), sorted_points.begin(), is_less);
+
+        if (sorted_points.size() <= 1) return sorted_points;
+
+        // Monotone chain: the upper hull from left to right, then the lower hull from right to left, dropping collinear and repeated points.
+        hull.reserve(sorted_points.size() + 1);
+        for (std::size_t i = 0; i < sorted_points.size(); ++i) {
+
+            while (hull.size() >= 2 && turn(hull[hull.size() - 2], hull.back(), sorted_points[i]) >= 0.0) hull.pop_back();
+            hull.push_back(sorted_points[i]);
+
+        }
+        for (std::size_t i = sorted_points.size() - 1, upper_size = hull.size(); i-- > 0;) {
+
+            while (hull.size() > upper_size && turn(hull[hull.size() - 2], hull.back(), sorted_points[i]) >= 0.0) hull.pop_back();
+            hull.push_back(sorted_points[i]);
+
+        }
+
+        // The first point was added again to close the lower hull.
+        hull.pop_back();
+        if (hull.size() == 2 && hull[0] == hull[1]) hull.pop_back();
+
+        return hull;
+
+    }
+
+    std::vector<glm::vec2> QuickHull::merge_hulls (std::vector<std::vector<glm::vec2>> const& hulls, std::size_t begin, std::size_t end) {
+
+        if (end - begin == 1) return hulls[begin];
+
+        std::size_t middle = begin + (end - begin) / 2;
+
+        return QuickHull::merge_hulls(QuickHull::merge_hulls(hulls, begin, middle), QuickHull::merge_hulls(hulls, middle, end));
+
+    }
+
+    std::vector<glm::vec2> QuickHull::merge_hulls (std::vector<std::vector<glm::vec2>> const& hulls) {
+
+        if (hulls.empty()) return std::vector<glm::vec2>();
+
+        return QuickHull::merge_hulls(hulls, 0, hulls.size());
+
+    }
+
+}
@@ -8,6 +8,7 @@
 #include <vector>
 #include <utility>
 #include <glm/vec2.hpp>
+#include "CompactPoints.hpp"
 
 namespace triangulation {
 
@@ -17,14 +18,36 @@ namespace triangulation {
 
             static std::vector<glm::vec2> compute_hull (std::vector<glm::vec2> const& points, glm::vec2 const& pivot_low, glm::vec2 const& pivot_high);
 
-            static std::pair<std::vector<glm::vec2>, std::vector<glm::vec2>> divide (std::vector<glm::vec2> const& points, glm::vec2 const& pivot_low, glm::vec2 const& pivot_high);
+            // Points is any container with size() and operator[] returning a glm::vec2 (std::vector<glm::vec2> or CompactPoints).
+            template <typename Points>
+            static std::pair<std::vector<glm::vec2>, std::vector<glm::vec2>> divide (Points const& points, glm::vec2 const& pivot_low, glm::vec2 const& pivot_high);
+
+            template <typename Points>
+            static std::vector<glm::vec2> compute_full_hull (Points const& points);
 
             static std::vector<glm::vec2> combine (std::vector<glm::vec2> const& points1, std::vector<glm::vec2> const& points2);
 
+            // Appends to chain the hull vertices from the lexicographically smallest to the largest, going one way around the hull.
+            static void split_chains (std::vector<glm::vec2> const& hull, std::vector<glm::vec2>& chain1, std::vector<glm::vec2>& chain2);
+
+            static std::vector<glm::vec2> merge_hulls (std::vector<std::vector<glm::vec2>> const& hulls, std::size_t begin, std::size_t end);
+
         public:
 
+            // Hull vertices clockwise from the lexicographically smallest point, without collinear or repeated points.
             static std::vector<glm::vec2> compute_hull (std::vector<glm::vec2> const& points);
 
+            // Only the first partitioning step reads the quantized points, the hull is returned dequantized.
+            static std::vector<glm::vec2> compute_hull (CompactPoints const& points);
+
+            // Hull of the union of two hulls, in the same form as compute_hull, so that both give the same vertices for the same points.
+            // Both hulls are split into two lexicographically sorted chains, which are merged and swept once (monotone chain),
+            // so the cost is linear in the hull sizes and independent of the number of points.
+            static std::vector<glm::vec2> merge_hulls (std::vector<glm::vec2> const& hull1, std::vector<glm::vec2> const& hull2);
+
+            // Merges the hulls pairwise, divide and conquer.
+            static std::vector<glm::vec2> merge_hulls (std::vector<std::vector<glm::vec2>> const& hulls);
+
     };
 
 }
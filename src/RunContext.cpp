@@ -0,0 +1,43 @@
+#include "RunContext.hpp"
+
+namespace triangulation {
+
+    RunContext::RunContext () : cancel(nullptr), has_deadline(false) {}
+
+    RunContext::RunContext (std::atomic<bool> const* _cancel) : cancel(_cancel), has_deadline(false) {}
+
+    void RunContext::set_cancel_token (std::atomic<bool> const* _cancel) {
+
+        this->cancel = _cancel;
+
+    }
+
+    void RunContext::set_deadline (Clock::time_point _deadline) {
+
+        this->deadline = _deadline;
+        this->has_deadline = true;
+
+    }
+
+    void RunContext::set_time_budget (Clock::duration time_budget) {
+
+        this->set_deadline(Clock::now() + time_budget);
+
+    }
+
+    bool RunContext::should_stop () const {
+
+        return this->get_stop_reason() != NOT_STOPPED;
+
+    }
+
+    RunContext::StopReason RunContext::get_stop_reason () const {
+
+        if (this->cancel != nullptr && this->cancel->load(std::memory_order_relaxed)) return CANCELLED;
+        if (this->has_deadline && Clock::now() >= this->deadline) return DEADLINE_EXCEEDED;
+
+        return NOT_STOPPED;
+
+    }
+
+}
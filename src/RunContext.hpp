@@ -0,0 +1,53 @@
+#ifndef TRIANGULATION_RUNCONTEXT_HPP
+#define TRIANGULATION_RUNCONTEXT_HPP
+
+#include <atomic>
+#include <chrono>
+
+namespace triangulation {
+
+    // Conditions under which a long run stops early: a cancellation token set by another thread and a deadline.
+    // The engine polls should_stop() from its loops; the context is only read, so one context can be shared by concurrent runs.
+    class RunContext {
+
+        public:
+
+            using Clock = std::chrono::steady_clock;
+
+            enum StopReason {
+
+                NOT_STOPPED,
+                CANCELLED,
+                DEADLINE_EXCEEDED
+
+            };
+
+        private:
+
+            std::atomic<bool> const* cancel;
+            Clock::time_point deadline;
+            bool has_deadline;
+
+        public:
+
+            // No token and no deadline: the run is never stopped.
+            RunContext ();
+            RunContext (std::atomic<bool> const* _cancel);
+
+            // The run stops once the token becomes true. The token must outlive the runs using the context.
+            void set_cancel_token (std::atomic<bool> const* _cancel);
+
+            void set_deadline (Clock::time_point _deadline);
+            // Deadline of time_budget from now.
+            void set_time_budget (Clock::duration time_budget);
+
+            bool should_stop () const;
+
+            // Why the run should stop now; cancellation takes precedence over the deadline.
+            StopReason get_stop_reason () const;
+
+    };
+
+}
+
+#endif
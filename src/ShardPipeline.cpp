@@ -0,0 +1,439 @@
+#include "ShardPipeline.hpp"
+#include "SweepHull.hpp"
+#include "QuickHull.hpp"
+#include "PointGrid.hpp"
+#include "Stitcher.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <stdexcept>
+#include <unordered_map>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <glm/glm.hpp>
+
+extern char** environ;
+
+namespace triangulation {
+
+    namespace {
+
+        const std::uint32_t shard_magic = 0x44524853; // "SHRD"
+        const std::uint32_t result_magic = 0x49525453; // "STRI"
+
+        template <typename T>
+        void write_value (std::ofstream& file, T const& value) {
+
+            file.write(reinterpret_cast<char const*>(&value), sizeof(T));
+
+        }
+
+        template <typename T>
+        T read_value (std::ifstream& file) {
+
+            T value;
+            file.read(reinterpret_cast<char*>(&value), sizeof(T));
+            return value;
+
+        }
+
+        template <typename T>
+        void write_array (std::ofstream& file, std::vector<T> const& values) {
+
+            write_value<std::uint64_t>(file, values.size());
+            file.write(reinterpret_cast<char const*>(values.data()), values.size() * sizeof(T));
+
+        }
+
+        template <typename T>
+        std::vector<T> read_array (std::ifstream& file) {
+
+            std::vector<T> values(read_value<std::uint64_t>(file));
+            file.read(reinterpret_cast<char*>(values.data()), values.size() * sizeof(T));
+            return values;
+
+        }
+
+        std::uint64_t get_edge_key (std::uint32_t v1, std::uint32_t v2) {
+
+            return (static_cast<std::uint64_t>(std::min(v1, v2)) << 32) | std::max(v1, v2);
+
+        }
+
+    }
+
+    bool ShardPipeline::is_in_box (glm::vec2 point, glm::vec2 box_min, glm::vec2 box_max) {
+
+        return point.x >= box_min.x && point.x < box_max.x && point.y >= box_min.y && point.y < box_max.y;
+
+    }
+
+    std::vector<std::string> ShardPipeline::partition (std::vector<glm::vec2> const& points, std::string const& directory, std::size_t shards_x, std::size_t shards_y, float margin) {
+
+        if (shards_x == 0 || shards_y == 0) throw std::invalid_argument("Error: The shard grid must have at least one shard!");
+
+        std::vector<std::string> shard_paths;
+        std::vector<std::uint32_t> order(points.size());
+        glm::vec2
+            min_corner(std::numeric_limits<float>::max()),
+            max_corner(-std::numeric_limits<float>::max());
+        const float infinity = std::numeric_limits<float>::infinity();
+
+        std::filesystem::create_directories(directory);
+        ShardPipeline::write_points((std::filesystem::path(directory) / "points.bin").string(), points);
+
+        for (std::uint32_t i = 0; i < points.size(); i++) {
+
+            order[i] = i;
+            min_corner = glm::min(min_corner, points[i]);
+            max_corner = glm::max(max_corner, points[i]);
+
+        }
+
+        // Splitting into columns at x quantiles, then each column into cells at y quantiles, so every shard gets about as many points.
+        std::sort(order.begin(), order.end(), [&points] (std::uint32_t a, std::uint32_t b) { return points[a].x < points[b].x; });
+
+        for (std::size_t column = 0; column < shards_x; column++) {
+
+            std::size_t
+                column_begin = column * points.size() / shards_x,
+                column_end = (column + 1) * points.size() / shards_x;
+            float
+                x_min = (column == 0 || column_begin >= points.size()) ? -infinity : points[order[column_begin]].x,
+                x_max = (column + 1 == shards_x || column_end >= points.size()) ? infinity : points[order[column_end]].x;
+
+            // Points sharing the split coordinate belong to the next column.
+            std::vector<std::uint32_t> column_points;
+            for (std::uint32_t i = 0; i < points.size(); i++) {
+
+                if (points[i].x >= x_min && points[i].x < x_max) column_points.push_back(i);
+
+            }
+            std::sort(column_points.begin(), column_points.end(), [&points] (std::uint32_t a, std::uint32_t b) { return points[a].y < points[b].y; });
+
+            for (std::size_t row = 0; row < shards_y; row++) {
+
+                std::size_t
+                    row_begin = row * column_points.size() / shards_y,
+                    row_end = (row + 1) * column_points.size() / shards_y;
+                Shard shard;
+
+                shard.index = column * shards_y + row;
+                shard.core_min = glm::vec2(x_min, (row == 0 || row_begin >= column_points.size()) ? -infinity : points[column_points[row_begin]].y);
+                shard.core_max = glm::vec2(x_max, (row + 1 == shards_y || row_end >= column_points.size()) ? infinity : points[column_points[row_end]].y);
+
+                // The overlap margin is relative to the part of the cell inside the bounding box of the points.
+                glm::vec2
+                    cell_min = glm::max(shard.core_min, min_corner),
+                    cell_max = glm::min(shard.core_max, max_corner),
+                    extent = glm::max(cell_max - cell_min, glm::vec2(0.0f));
+                float margin_size = margin * std::max(extent.x, extent.y);
+
+                shard.region_min = cell_min - glm::vec2(margin_size);
+                shard.region_max = cell_max + glm::vec2(margin_size);
+
+                for (std::uint32_t i = 0; i < points.size(); i++) {
+
+                    if (glm::all(glm::greaterThanEqual(points[i], shard.region_min)) && glm::all(glm::lessThanEqual(points[i], shard.region_max))) {
+
+                        shard.points.push_back(points[i]);
+                        shard.global_indices.push_back(i);
+
+                    }
+
+                }
+
+                shard_paths.push_back((std::filesystem::path(directory) / ("shard_" + std::to_string(shard.index) + ".bin")).string());
+                ShardPipeline::write_shard(shard_paths.back(), shard);
+
+            }
+
+        }
+
+        return shard_paths;
+
+    }
+
+    void ShardPipeline::write_shard (std::string const& path, Shard const& shard) {
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) throw std::runtime_error("Error: Failed to open file " + path + "!");
+
+        write_value(file, shard_magic);
+        write_value(file, shard.index);
+        write_value(file, shard.core_min);
+        write_value(file, shard.core_max);
+        write_value(file, shard.region_min);
+        write_value(file, shard.region_max);
+        write_array(file, shard.points);
+        write_array(file, shard.global_indices);
+
+        if (!file) throw std::runtime_error("Error: Failed to write file " + path + "!");
+
+    }
+
+    ShardPipeline::Shard ShardPipeline::read_shard (std::string const& path) {
+
+        std::ifstream file(path, std::ios::binary);
+        Shard shard;
+
+        if (!file.is_open()) throw std::runtime_error("Error: Failed to open file " + path + "!");
+        if (read_value<std::uint32_t>(file) != shard_magic) throw std::runtime_error("Error: " + path + " is not a shard file!");
+
+        shard.index = read_value<std::uint32_t>(file);
+        shard.core_min = read_value<glm::vec2>(file);
+        shard.core_max = read_value<glm::vec2>(file);
+        shard.region_min = read_value<glm::vec2>(file);
+        shard.region_max = read_value<glm::vec2>(file);
+        shard.points = read_array<glm::vec2>(file);
+        shard.global_indices = read_array<std::uint32_t>(file);
+
+        if (!file || shard.points.size() != shard.global_indices.size()) throw std::runtime_error("Error: Failed to read shard file " + path + "!");
+
+        return shard;
+
+    }
+
+    std::vector<std::string> ShardPipeline::find_shards (std::string const& directory) {
+
+        std::vector<std::pair<std::uint32_t, std::string>> shards;
+        std::vector<std::string> shard_paths;
+
+        for (auto const& entry : std::filesystem::directory_iterator(directory)) {
+
+            std::string name = entry.path().filename().string();
+
+            if (name.rfind("shard_", 0) == 0 && entry.path().extension() == ".bin") {
+
+                shards.emplace_back(std::stoul(name.substr(6)), entry.path().string());
+
+            }
+
+        }
+        std::sort(shards.begin(), shards.end());
+
+        for (auto const& shard : shards) {
+
+            shard_paths.push_back(shard.second);
+
+        }
+
+        return shard_paths;
+
+    }
+
+    std::string ShardPipeline::get_result_path (std::string const& shard_path) {
+
+        return std::filesystem::path(shard_path).replace_extension(".tri").string();
+
+    }
+
+    void ShardPipeline::triangulate_shard (std::string const& shard_path) {
+
+        Shard shard = ShardPipeline::read_shard(shard_path);
+        std::vector<std::uint32_t> indices = SweepHull::compute_triangulation_indices(shard.points);
+        std::string result_path = ShardPipeline::get_result_path(shard_path);
+
+        for (auto& index : indices) {
+
+            index = shard.global_indices[index];
+
+        }
+
+        // Writing to a temporary file first, so an interrupted worker never leaves a truncated result.
+        {
+
+            std::ofstream file(result_path + ".tmp", std::ios::binary | std::ios::trunc);
+            if (!file.is_open()) throw std::runtime_error("Error: Failed to open file " + result_path + ".tmp!");
+
+            write_value(file, result_magic);
+            write_array(file, indices);
+
+            if (!file) throw std::runtime_error("Error: Failed to write file " + result_path + ".tmp!");
+
+        }
+        std::filesystem::rename(result_path + ".tmp", result_path);
+
+    }
+
+    void ShardPipeline::run_workers (std::string const& executable, std::vector<std::string> const& shard_paths, std::size_t process_count) {
+
+        std::map<pid_t, std::string> running;
+        std::size_t next = 0;
+        bool failed = false;
+
+        process_count = std::max<std::size_t>(1, process_count);
+
+        while (next < shard_paths.size() || !running.empty()) {
+
+            // Starting workers until process_count are running.
+            while (!failed && next < shard_paths.size() && running.size() < process_count) {
+
+                std::string argument = "--triangulate-shard=" + shard_paths[next];
+                char* argv[] = {const_cast<char*>(executable.c_str()), const_cast<char*>(argument.c_str()), nullptr};
+                pid_t pid;
+
+                if (posix_spawn(&pid, executable.c_str(), nullptr, nullptr, argv, environ) != 0) throw std::runtime_error("Error: Failed to start worker " + executable + "!");
+                running[pid] = shard_paths[next];
+                next++;
+
+            }
+
+            if (running.empty()) break;
+
+            int status;
+            pid_t pid = waitpid(-1, &status, 0);
+
+            if (pid < 0) {
+
+                if (errno == EINTR) continue;
+                throw std::runtime_error("Error: Failed to wait for the shard workers!");
+
+            }
+            if (running.count(pid) == 0) continue;
+
+            if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) failed = true;
+            running.erase(pid);
+
+        }
+
+        if (failed) throw std::runtime_error("Error: A shard worker failed!");
+
+    }
+
+    ShardPipeline::MergeResult ShardPipeline::merge (std::string const& directory, std::vector<std::string> const& shard_paths) {
+
+        MergeResult result;
+        std::vector<glm::vec2> points = ShardPipeline::read_points((std::filesystem::path(directory) / "points.bin").string());
+        PointGrid grid(points);
+
+        for (auto const& shard_path : shard_paths) {
+
+            Shard shard = ShardPipeline::read_shard(shard_path);
+            std::string result_path = ShardPipeline::get_result_path(shard_path);
+            std::ifstream file(result_path, std::ios::binary);
+
+            if (!file.is_open()) throw std::runtime_error("Error: Failed to open file " + result_path + "!");
+            if (read_value<std::uint32_t>(file) != result_magic) throw std::runtime_error("Error: " + result_path + " is not a shard result file!");
+
+            std::vector<std::uint32_t> indices = read_array<std::uint32_t>(file);
+            if (!file) throw std::runtime_error("Error: Failed to read shard result file " + result_path + "!");
+
+            // A stale result of another partition, or a corrupt one, may index past the points.
+            for (auto const& index : indices) {
+
+                if (index >= points.size()) throw std::runtime_error("Error: " + result_path + " indexes point " + std::to_string(index) + " of " + std::to_string(points.size()) + "!");
+
+            }
+
+            for (std::size_t t = 0; t + 2 < indices.size(); t += 3) {
+
+                glm::vec2 vertices[3] = {points[indices[t]], points[indices[t + 1]], points[indices[t + 2]]};
+
+                // Each triangle is owned by the shard whose core contains its centroid.
+                if (!ShardPipeline::is_in_box((vertices[0] + vertices[1] + vertices[2]) / 3.0f, shard.core_min, shard.core_max)) continue;
+
+                glm::dvec2 center;
+                double radius;
+
+                // Keeping only the triangles with no other point inside or on their circumcircle, which every shard agrees on;
+                // the cocircular sets are left to fill_gaps, so two shards never keep crossing diagonals.
+                if (!PointGrid::compute_circumcircle(vertices, center, radius)) continue;
+
+                if (grid.is_circle_empty(center, radius, vertices, false)) {
+
+                    result.indices.insert(result.indices.end(), indices.begin() + t, indices.begin() + t + 3);
+
+                }
+
+            }
+
+        }
+
+        // Triangles too large for any shard region, such as long slivers along the convex hull, are missing from every shard.
+        Stitcher::fill_gaps(points, grid, result.indices);
+        ShardPipeline::check_edges(points, result);
+
+        return result;
+
+    }
+
+    void ShardPipeline::check_edges (std::vector<glm::vec2> const& points, MergeResult& result) {
+
+        std::unordered_map<std::uint64_t, std::uint32_t> edge_counts;
+        std::vector<glm::vec2> hull = QuickHull::compute_hull(points);
+
+        // Boundary edges are expected only along the convex hull, possibly splitting a hull side at collinear points.
+        auto is_on_hull = [&hull] (glm::vec2 p1, glm::vec2 p2) {
+
+            for (std::size_t i = 0; i < hull.size(); i++) {
+
+                glm::dvec2
+                    side_start(hull[i]),
+                    side = glm::dvec2(hull[(i + 1) % hull.size()]) - side_start,
+                    offset1 = glm::dvec2(p1) - side_start,
+                    offset2 = glm::dvec2(p2) - side_start;
+                double tolerance = 1e-7 * glm::length(side);
+
+                if (std::abs(side.x * offset1.y - side.y * offset1.x) <= tolerance * glm::length(offset1) &&
+                    std::abs(side.x * offset2.y - side.y * offset2.x) <= tolerance * glm::length(offset2)) return true;
+
+            }
+
+            return false;
+
+        };
+
+        for (std::size_t t = 0; t + 2 < result.indices.size(); t += 3) {
+
+            for (std::size_t k = 0; k < 3; k++) {
+
+                edge_counts[get_edge_key(result.indices[t + k], result.indices[t + (k + 1) % 3])]++;
+
+            }
+
+        }
+
+        result.gap_edges = 0;
+        result.conflicting_edges = 0;
+        for (auto const& [key, count] : edge_counts) {
+
+            if (count == 1 && !is_on_hull(points[key >> 32], points[key & 0xFFFFFFFF])) result.gap_edges++;
+            if (count > 2) result.conflicting_edges++;
+
+        }
+
+    }
+
+    void ShardPipeline::write_points (std::string const& path, std::vector<glm::vec2> const& points) {
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) throw std::runtime_error("Error: Failed to open file " + path + "!");
+
+        file.write(reinterpret_cast<char const*>(points.data()), points.size() * sizeof(glm::vec2));
+
+        if (!file) throw std::runtime_error("Error: Failed to write file " + path + "!");
+
+    }
+
+    std::vector<glm::vec2> ShardPipeline::read_points (std::string const& path) {
+
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file.is_open()) throw std::runtime_error("Error: Failed to open file " + path + "!");
+
+        std::vector<glm::vec2> points(static_cast<std::size_t>(file.tellg()) / sizeof(glm::vec2));
+
+        file.seekg(0);
+        file.read(reinterpret_cast<char*>(points.data()), points.size() * sizeof(glm::vec2));
+
+        if (!file) throw std::runtime_error("Error: Failed to read file " + path + "!");
+
+        return points;
+
+    }
+
+}
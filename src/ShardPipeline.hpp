@@ -0,0 +1,84 @@
+#ifndef TRIANGULATION_SHARDPIPELINE_HPP
+#define TRIANGULATION_SHARDPIPELINE_HPP
+
+#include <vector>
+#include <string>
+#include <cstdint>
+#include <glm/vec2.hpp>
+
+namespace triangulation {
+
+    // Triangulates large point sets as independent spatial shards, each in its own process, then merges them.
+    //  1. partition: splits the points into a grid of shards balanced by quantiles. Each shard gets its core cell plus an overlap margin,
+    //     and the shards and all the points are written to a directory.
+    //  2. triangulate_shard: run by worker processes, reads one shard file and writes the SweepHull (Delaunay) triangles of its points
+    //     with their global indices.
+    //  3. merge: each shard contributes the triangles whose centroid lies in its core and whose circumcircle holds no other point,
+    //     not even on the circle: those belong to every Delaunay triangulation of the points, so the shards agree on them.
+    //     The rest, like slivers along the convex hull too large for any shard region and cocircular points, is recovered by
+    //     Stitcher::fill_gaps from the boundary of the merged triangles.
+    //     Any gaps left are counted so the caller can retry with a larger margin.
+    class ShardPipeline {
+
+        public:
+
+            struct Shard {
+
+                std::uint32_t index;
+                // Core cell (the outer cells extend to infinity) and the region whose points the shard triangulates.
+                glm::vec2 core_min, core_max;
+                glm::vec2 region_min, region_max;
+                std::vector<glm::vec2> points;
+                std::vector<std::uint32_t> global_indices;
+
+            };
+
+            struct MergeResult {
+
+                std::vector<std::uint32_t> indices;
+                // Edges with a triangle on one side only that are not on the convex hull, and edges shared by more than two triangles.
+                std::size_t gap_edges = 0;
+                std::size_t conflicting_edges = 0;
+
+            };
+
+        private:
+
+            static bool is_in_box (glm::vec2 point, glm::vec2 box_min, glm::vec2 box_max);
+
+            static void write_shard (std::string const& path, Shard const& shard);
+
+            // Counts the boundary edges that are not on the convex hull of the points, and the edges used more than twice.
+            static void check_edges (std::vector<glm::vec2> const& points, MergeResult& result);
+
+        public:
+
+            // Writes the points to <directory>/points.bin and shards_x * shards_y shard files, returning their paths.
+            // The margin is a fraction of the size of each cell.
+            static std::vector<std::string> partition (std::vector<glm::vec2> const& points, std::string const& directory, std::size_t shards_x, std::size_t shards_y, float margin = 0.25f);
+
+            static Shard read_shard (std::string const& path);
+
+            // Shard files written by partition in the directory, sorted by shard index.
+            static std::vector<std::string> find_shards (std::string const& directory);
+
+            // Result file of a shard file: <directory>/shard_<k>.tri for <directory>/shard_<k>.bin.
+            static std::string get_result_path (std::string const& shard_path);
+
+            // Triangulates the shard and writes its triangles, as global indices, to the result file.
+            static void triangulate_shard (std::string const& shard_path);
+
+            // Runs "<executable> --triangulate-shard=<path>" for every shard, with at most process_count processes at once.
+            static void run_workers (std::string const& executable, std::vector<std::string> const& shard_paths, std::size_t process_count);
+
+            static MergeResult merge (std::string const& directory, std::vector<std::string> const& shard_paths);
+
+            // Points file of the partition, in the format of the triangulation service: little-endian float32 x, y pairs.
+            static void write_points (std::string const& path, std::vector<glm::vec2> const& points);
+            static std::vector<glm::vec2> read_points (std::string const& path);
+
+    };
+
+}
+
+#endif
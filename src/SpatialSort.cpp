@@ -0,0 +1,169 @@
+#include "SpatialSort.hpp"
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <glm/glm.hpp>
+
+namespace triangulation {
+
+    std::uint32_t SpatialSort::compute_morton_key (std::uint32_t x, std::uint32_t y) {
+
+        // Spreading the 16 bits of each coordinate over the even positions.
+        auto spread = [] (std::uint32_t v) {
+
+            v = (v | (v << 8)) & 0x00FF00FF;
+            v = (v | (v << 4)) & 0x0F0F0F0F;
+            v = (v | (v << 2)) & 0x33333333;
+            v = (v | (v << 1)) & 0x55555555;
+            return v;
+
+        };
+
+        return spread(x) | (spread(y) << 1);
+
+    }
+
+    std::uint32_t SpatialSort::compute_hilbert_key (std::uint32_t x, std::uint32_t y) {
+
+        std::uint32_t rx, ry, key = 0;
+
+        for (std::uint32_t s = 1u << (curve_bits - 1); s > 0; s >>= 1) {
+
+            rx = (x & s) > 0;
+            ry = (y & s) > 0;
+            key += s * s * ((3 * rx) ^ ry);
+
+            // Rotating the quadrant so the curve stays continuous.
+            if (ry == 0) {
+
+                if (rx == 1) {
+
+                    x = s - 1 - (x & (s - 1));
+                    y = s - 1 - (y & (s - 1));
+
+                }
+
+                std::swap(x, y);
+
+            }
+
+        }
+
+        return key;
+
+    }
+
+    std::vector<std::uint32_t> SpatialSort::compute_keys (std::vector<glm::vec2> const& points, CurveType curve) {
+
+        std::vector<std::uint32_t> keys(points.size());
+
+        if (points.empty()) return keys;
+
+        glm::vec2
+            min_corner = points[0],
+            max_corner = points[0],
+            extent;
+        float scale;
+        const float max_coordinate = static_cast<float>((1u << curve_bits) - 1);
+
+        for (auto const& point : points) {
+
+            min_corner = glm::min(min_corner, point);
+            max_corner = glm::max(max_corner, point);
+
+        }
+
+        // Using the same scale on both axes keeps the curve cells square.
+        extent = max_corner - min_corner;
+        scale = std::max(extent.x, extent.y);
+        scale = (scale > 0.0f) ? max_coordinate / scale : 0.0f;
+
+        for (std::size_t i = 0; i < points.size(); ++i) {
+
+            std::uint32_t
+                x = static_cast<std::uint32_t>((points[i].x - min_corner.x) * scale),
+                y = static_cast<std::uint32_t>((points[i].y - min_corner.y) * scale);
+
+            keys[i] = (curve == MORTON) ? SpatialSort::compute_morton_key(x, y) : SpatialSort::compute_hilbert_key(x, y);
+
+        }
+
+        return keys;
+
+    }
+
+    void SpatialSort::sort_range (std::vector<std::uint32_t>& order, std::size_t begin, std::size_t end, std::vector<std::uint32_t> const& keys) {
+
+        std::sort(order.begin() + begin, order.begin() + end, [&keys] (std::uint32_t a, std::uint32_t b) {
+
+            return keys[a] < keys[b] || (keys[a] == keys[b] && a < b);
+
+        });
+
+    }
+
+    std::vector<std::uint32_t> SpatialSort::compute_order (std::vector<glm::vec2> const& points, CurveType curve) {
+
+        std::vector<std::uint32_t> keys = SpatialSort::compute_keys(points, curve);
+        std::vector<std::uint32_t> order(points.size());
+
+        std::iota(order.begin(), order.end(), 0);
+        SpatialSort::sort_range(order, 0, order.size(), keys);
+
+        return order;
+
+    }
+
+    std::vector<std::uint32_t> SpatialSort::compute_brio_order (std::vector<glm::vec2> const& points, std::uint32_t seed, CurveType curve) {
+
+        // Rounds smaller than this are merged into the first one.
+        const std::size_t min_round_size = 64;
+
+        std::vector<std::uint32_t> keys = SpatialSort::compute_keys(points, curve);
+        std::vector<std::uint32_t> order(points.size());
+        std::mt19937 generator(seed);
+        std::size_t begin, end = order.size();
+
+        std::iota(order.begin(), order.end(), 0);
+        std::shuffle(order.begin(), order.end(), generator);
+
+        // The last round holds half of the points, the one before it a quarter, and so on.
+        while (end > min_round_size) {
+
+            begin = end / 2;
+            SpatialSort::sort_range(order, begin, end, keys);
+            end = begin;
+
+        }
+        SpatialSort::sort_range(order, 0, end, keys);
+
+        return order;
+
+    }
+
+    std::vector<glm::vec2> SpatialSort::apply_order (std::vector<glm::vec2> const& points, std::vector<std::uint32_t> const& order) {
+
+        std::vector<glm::vec2> sorted_points;
+
+        sorted_points.reserve(order.size());
+        for (auto const& index : order) {
+
+            sorted_points.push_back(points[index]);
+
+        }
+
+        return sorted_points;
+
+    }
+
+    void SpatialSort::restore_indices (std::vector<std::uint32_t>& indices, std::vector<std::uint32_t> const& order) {
+
+        for (auto& index : indices) {
+
+            index = order[index];
+
+        }
+
+    }
+
+}
@@ -0,0 +1,53 @@
+#ifndef TRIANGULATION_SPATIALSORT_HPP
+#define TRIANGULATION_SPATIALSORT_HPP
+
+#include <vector>
+#include <cstdint>
+#include <glm/vec2.hpp>
+
+namespace triangulation {
+
+    enum CurveType {
+
+        MORTON,
+        HILBERT
+
+    };
+
+    // Reorders points along a space-filling curve so that points close in memory are also close in the plane.
+    // Every function returns a permutation: position i of the sorted sequence holds the original index order[i].
+    class SpatialSort {
+
+        private:
+
+            // Number of bits per axis used to quantize the coordinates.
+            static constexpr unsigned int curve_bits = 16;
+
+            static std::uint32_t compute_morton_key (std::uint32_t x, std::uint32_t y);
+
+            static std::uint32_t compute_hilbert_key (std::uint32_t x, std::uint32_t y);
+
+            // Computes the curve key of each point, quantized relative to the bounding box of all points.
+            static std::vector<std::uint32_t> compute_keys (std::vector<glm::vec2> const& points, CurveType curve);
+
+            // Sorts order[begin, end) by key.
+            static void sort_range (std::vector<std::uint32_t>& order, std::size_t begin, std::size_t end, std::vector<std::uint32_t> const& keys);
+
+        public:
+
+            static std::vector<std::uint32_t> compute_order (std::vector<glm::vec2> const& points, CurveType curve = HILBERT);
+
+            // Biased randomized insertion order: the points are shuffled into rounds of doubling size and each round is sorted along the curve.
+            static std::vector<std::uint32_t> compute_brio_order (std::vector<glm::vec2> const& points, std::uint32_t seed = 0, CurveType curve = HILBERT);
+
+            // Returns the points in the given order.
+            static std::vector<glm::vec2> apply_order (std::vector<glm::vec2> const& points, std::vector<std::uint32_t> const& order);
+
+            // Maps indices referring to the sorted points back to indices into the original points.
+            static void restore_indices (std::vector<std::uint32_t>& indices, std::vector<std::uint32_t> const& order);
+
+    };
+
+}
+
+#endif
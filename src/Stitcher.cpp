@@ -0,0 +1,227 @@
+#include "Stitcher.hpp"
+#include "SweepHull.hpp"
+#include "EdgeFlip.hpp"
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+#include <glm/glm.hpp>
+
+namespace triangulation {
+
+    Stitcher::Stitcher (std::vector<std::vector<glm::vec2>> const& groups) : points(Stitcher::concatenate(groups)), grid(this->points) {
+
+        std::unordered_map<std::uint64_t, std::uint32_t> first_indices;
+
+        for (std::uint32_t i = 0; i < this->points.size(); i++) {
+
+            std::uint64_t key;
+            std::uint32_t coordinates[2];
+
+            // Points with the same coordinates, in the same group or not, share the index of the first one.
+            std::memcpy(coordinates, &this->points[i], sizeof(coordinates));
+            key = (static_cast<std::uint64_t>(coordinates[0]) << 32) | coordinates[1];
+            this->canonical_indices.push_back(first_indices.emplace(key, i).first->second);
+            if (this->canonical_indices[i] == i) this->unused_points.insert(i);
+
+        }
+
+        std::size_t offset = 0;
+        for (auto const& group : groups) {
+
+            this->group_offsets.push_back(offset);
+            offset += group.size();
+
+        }
+
+    }
+
+    std::vector<glm::vec2> Stitcher::concatenate (std::vector<std::vector<glm::vec2>> const& groups) {
+
+        std::vector<glm::vec2> points;
+
+        for (auto const& group : groups) {
+
+            points.insert(points.end(), group.begin(), group.end());
+
+        }
+
+        return points;
+
+    }
+
+    void Stitcher::add_group (std::size_t group, std::vector<std::uint32_t> group_triangulation) {
+
+        std::size_t
+            offset = this->group_offsets[group],
+            size = ((group + 1 < this->group_offsets.size()) ? this->group_offsets[group + 1] : this->points.size()) - offset;
+        std::vector<glm::vec2> group_points(this->points.begin() + offset, this->points.begin() + offset + size);
+
+        // AdvancingFront triangulations are not always Delaunay: flipping them first keeps more of their triangles.
+        EdgeFlip::make_delaunay(group_points, group_triangulation, 1);
+
+        for (std::size_t t = 0; t + 2 < group_triangulation.size(); t += 3) {
+
+            std::array<std::uint32_t, 3> triangle = {
+                this->canonical_indices[offset + group_triangulation[t]],
+                this->canonical_indices[offset + group_triangulation[t + 1]],
+                this->canonical_indices[offset + group_triangulation[t + 2]]
+            };
+            glm::vec2 vertices[3] = {this->points[triangle[0]], this->points[triangle[1]], this->points[triangle[2]]};
+            glm::dvec2 center;
+            double radius;
+
+            // Keeping only the triangles of every Delaunay triangulation of the whole set: no point inside or on the circumcircle.
+            // The groups only saw their own points, and two groups may pick different diagonals of cocircular points, which would overlap.
+            if (!PointGrid::compute_circumcircle(vertices, center, radius) || !this->grid.is_circle_empty(center, radius, vertices, false)) continue;
+
+            std::array<std::uint32_t, 3> sorted_triangle = triangle;
+            std::sort(sorted_triangle.begin(), sorted_triangle.end());
+            if (this->triangles.insert(sorted_triangle).second) {
+
+                this->indices.insert(this->indices.end(), triangle.begin(), triangle.end());
+                Stitcher::add_to_boundary(triangle, this->boundary_edges);
+                for (auto const& vertex : triangle) {
+
+                    this->unused_points.erase(vertex);
+
+                }
+
+            }
+
+        }
+
+    }
+
+    void Stitcher::finish () {
+
+        std::vector<std::uint32_t> gap_indices(this->unused_points.begin(), this->unused_points.end());
+
+        for (auto const& key : this->boundary_edges) {
+
+            gap_indices.push_back(static_cast<std::uint32_t>(key >> 32));
+            gap_indices.push_back(static_cast<std::uint32_t>(key & 0xFFFFFFFF));
+
+        }
+
+        Stitcher::triangulate_gaps(this->points, this->grid, std::move(gap_indices), this->triangles, this->indices);
+
+    }
+
+    std::vector<std::uint32_t> const& Stitcher::get_indices () const {
+
+        return this->indices;
+
+    }
+
+    std::vector<std::uint32_t> Stitcher::stitch (std::vector<std::vector<glm::vec2>> const& groups, std::vector<std::vector<std::uint32_t>> const& group_triangulations) {
+
+        Stitcher stitcher(groups);
+
+        for (std::size_t g = 0; g < groups.size() && g < group_triangulations.size(); g++) {
+
+            stitcher.add_group(g, group_triangulations[g]);
+
+        }
+        stitcher.finish();
+
+        return std::move(stitcher.indices);
+
+    }
+
+    std::uint64_t Stitcher::get_edge_key (std::uint32_t vertex1, std::uint32_t vertex2) {
+
+        return (static_cast<std::uint64_t>(std::min(vertex1, vertex2)) << 32) | std::max(vertex1, vertex2);
+
+    }
+
+    void Stitcher::add_to_boundary (std::array<std::uint32_t, 3> const& triangle, std::unordered_set<std::uint64_t>& boundary_edges) {
+
+        for (std::size_t k = 0; k < 3; k++) {
+
+            std::uint64_t key = Stitcher::get_edge_key(triangle[k], triangle[(k + 1) % 3]);
+
+            // The kept triangles do not overlap: an edge is shared by two of them at most, and is inside once it is.
+            if (!boundary_edges.insert(key).second) boundary_edges.erase(key);
+
+        }
+
+    }
+
+    void Stitcher::fill_gaps (std::vector<glm::vec2> const& points, PointGrid const& grid, std::vector<std::uint32_t>& indices) {
+
+        std::set<std::array<std::uint32_t, 3>> triangles;
+        std::unordered_set<std::uint64_t> boundary_edges;
+        std::vector<bool> is_used(points.size(), false);
+        std::vector<std::uint32_t> gap_indices;
+
+        for (std::size_t t = 0; t + 2 < indices.size(); t += 3) {
+
+            std::array<std::uint32_t, 3> triangle = {indices[t], indices[t + 1], indices[t + 2]};
+
+            Stitcher::add_to_boundary(triangle, boundary_edges);
+            for (auto const& vertex : triangle) {
+
+                is_used[vertex] = true;
+
+            }
+            std::sort(triangle.begin(), triangle.end());
+            triangles.insert(triangle);
+
+        }
+
+        for (auto const& key : boundary_edges) {
+
+            gap_indices.push_back(static_cast<std::uint32_t>(key >> 32));
+            gap_indices.push_back(static_cast<std::uint32_t>(key & 0xFFFFFFFF));
+
+        }
+        for (std::uint32_t i = 0; i < points.size(); i++) {
+
+            if (!is_used[i]) gap_indices.push_back(i);
+
+        }
+
+        Stitcher::triangulate_gaps(points, grid, std::move(gap_indices), triangles, indices);
+
+    }
+
+    void Stitcher::triangulate_gaps (std::vector<glm::vec2> const& points, PointGrid const& grid, std::vector<std::uint32_t> gap_indices, std::set<std::array<std::uint32_t, 3>> const& triangles, std::vector<std::uint32_t>& indices) {
+
+        std::vector<glm::vec2> gap_points;
+
+        std::sort(gap_indices.begin(), gap_indices.end());
+        gap_indices.erase(std::unique(gap_indices.begin(), gap_indices.end()), gap_indices.end());
+
+        if (gap_indices.size() < 3) return;
+
+        for (auto const& index : gap_indices) {
+
+            gap_points.push_back(points[index]);
+
+        }
+
+        // Every Delaunay triangle of all the points with its vertices among the gap points is also a Delaunay triangle of theirs.
+        // Cocircular points are triangulated once, by the one sweep, so the gap triangles never cross each other.
+        std::vector<std::uint32_t> gap_triangulation = SweepHull::compute_triangulation_indices(gap_points);
+
+        for (std::size_t t = 0; t + 2 < gap_triangulation.size(); t += 3) {
+
+            std::array<std::uint32_t, 3> triangle = {gap_indices[gap_triangulation[t]], gap_indices[gap_triangulation[t + 1]], gap_indices[gap_triangulation[t + 2]]};
+            glm::vec2 vertices[3] = {points[triangle[0]], points[triangle[1]], points[triangle[2]]};
+            std::array<std::uint32_t, 3> sorted_triangle = triangle;
+
+            std::sort(sorted_triangle.begin(), sorted_triangle.end());
+            if (triangles.count(sorted_triangle) > 0) continue;
+
+            // Triangles of the gap points overlapping the kept triangles have points of the kept triangles inside their circumcircle.
+            if (grid.is_delaunay(vertices)) {
+
+                indices.insert(indices.end(), triangle.begin(), triangle.end());
+
+            }
+
+        }
+
+    }
+
+}
@@ -0,0 +1,74 @@
+#ifndef TRIANGULATION_STITCHER_HPP
+#define TRIANGULATION_STITCHER_HPP
+
+#include <vector>
+#include <array>
+#include <set>
+#include <unordered_set>
+#include <cstdint>
+#include <glm/vec2.hpp>
+#include "PointGrid.hpp"
+
+namespace triangulation {
+
+    // Combines triangulations of parts of a point set into the Delaunay triangulation of the whole set. The triangles whose
+    // circumcircle holds no other point of the whole set, not even on the circle, are kept as they are: they belong to every
+    // Delaunay triangulation of it. The gaps left between them, including sets of cocircular points, are filled by SweepHull.
+    class Stitcher {
+
+        private:
+
+            std::vector<glm::vec2> points;
+            // For each point, the first point with the same coordinates.
+            std::vector<std::uint32_t> canonical_indices;
+            std::vector<std::size_t> group_offsets;
+            PointGrid grid;
+            std::set<std::array<std::uint32_t, 3>> triangles;
+            std::vector<std::uint32_t> indices;
+            // Edges of a single kept triangle and points of no kept triangle, updated by add_group so that finish only visits the gaps.
+            std::unordered_set<std::uint64_t> boundary_edges;
+            std::unordered_set<std::uint32_t> unused_points;
+
+            static std::vector<glm::vec2> concatenate (std::vector<std::vector<glm::vec2>> const& groups);
+
+            static std::uint64_t get_edge_key (std::uint32_t vertex1, std::uint32_t vertex2);
+
+            // Adds the edges of a new triangle to the boundary, or removes those it shares with the triangles already there.
+            static void add_to_boundary (std::array<std::uint32_t, 3> const& triangle, std::unordered_set<std::uint64_t>& boundary_edges);
+
+            // Triangulates the gap points (the vertices of the boundary edges and the unused points) and adds the Delaunay triangles
+            // that are not among the kept triangles (sorted vertices).
+            static void triangulate_gaps (std::vector<glm::vec2> const& points, PointGrid const& grid, std::vector<std::uint32_t> gap_indices, std::set<std::array<std::uint32_t, 3>> const& triangles, std::vector<std::uint32_t>& indices);
+
+        public:
+
+            // Prepares to stitch triangulations of the groups, which can then be added one by one as they are done.
+            Stitcher (std::vector<std::vector<glm::vec2>> const& groups);
+
+            Stitcher (Stitcher const&) = delete;
+            Stitcher& operator = (Stitcher const&) = delete;
+
+            // Keeps the triangles of the group triangulation (indices into the group) that belong to the triangulation of all the points.
+            void add_group (std::size_t group, std::vector<std::uint32_t> group_triangulation);
+
+            // Fills the gaps left between the kept triangles, once every group is added. Only the boundary of the kept triangles and
+            // the points they do not use are visited, not the kept triangles themselves.
+            void finish ();
+
+            // Triangles so far, indexing the concatenated points; points with the same coordinates share the first index.
+            // Adding groups and finishing only append to them.
+            std::vector<std::uint32_t> const& get_indices () const;
+
+            // Triangulates the concatenation of the groups, reusing the triangulation of each group (indices into the group).
+            static std::vector<std::uint32_t> stitch (std::vector<std::vector<glm::vec2>> const& groups, std::vector<std::vector<std::uint32_t>> const& group_triangulations);
+
+            // Adds the missing Delaunay triangles to a set of triangles with strictly empty circumcircles. Every missing triangle has its
+            // vertices on the boundary of the current triangles or among the points they do not use, so only those few points are triangulated.
+            // Finding them takes a pass over all the triangles and points, which finish avoids by keeping them up to date.
+            static void fill_gaps (std::vector<glm::vec2> const& points, PointGrid const& grid, std::vector<std::uint32_t>& indices);
+
+    };
+
+}
+
+#endif
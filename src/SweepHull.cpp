@@ -0,0 +1,368 @@
+#include "SweepHull.hpp"
+#include "PointSnapper.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <glm/glm.hpp>
+
+namespace triangulation {
+
+    namespace {
+
+        constexpr std::uint32_t no_point = std::numeric_limits<std::uint32_t>::max();
+
+        double orientation (glm::dvec2 a, glm::dvec2 b, glm::dvec2 c) {
+
+            return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+
+        }
+
+        // Offset of the circumcenter of abc from a, or infinite for degenerate triangles.
+        glm::dvec2 get_circumcenter_offset (glm::dvec2 a, glm::dvec2 b, glm::dvec2 c) {
+
+            glm::dvec2 ab = b - a, ac = c - a;
+            double
+                d = 2.0 * (ab.x * ac.y - ab.y * ac.x),
+                ab_length = ab.x * ab.x + ab.y * ab.y,
+                ac_length = ac.x * ac.x + ac.y * ac.y;
+
+            if (d == 0.0) return glm::dvec2(std::numeric_limits<double>::infinity());
+            return glm::dvec2(ac.y * ab_length - ab.y * ac_length, ab.x * ac_length - ac.x * ab_length) / d;
+
+        }
+
+        // Whether d is strictly inside the circumcircle of the counterclockwise triangle abc.
+        bool is_in_circle (glm::dvec2 a, glm::dvec2 b, glm::dvec2 c, glm::dvec2 d) {
+
+            glm::dvec2 ad = a - d, bd = b - d, cd = c - d;
+            double
+                a_length = ad.x * ad.x + ad.y * ad.y,
+                b_length = bd.x * bd.x + bd.y * bd.y,
+                c_length = cd.x * cd.x + cd.y * cd.y;
+
+            return a_length * (bd.x * cd.y - cd.x * bd.y) - b_length * (ad.x * cd.y - cd.x * ad.y) + c_length * (ad.x * bd.y - bd.x * ad.y) > 0.0;
+
+        }
+
+        double squared_length (glm::dvec2 v) {
+
+            return v.x * v.x + v.y * v.y;
+
+        }
+
+    }
+
+    double SweepHull::get_pseudo_angle (double dx, double dy) {
+
+        double p = dx / (std::abs(dx) + std::abs(dy));
+        return (dy > 0.0 ? 3.0 - p : 1.0 + p) / 4.0;
+
+    }
+
+    AdvancingFront::Result SweepHull::triangulate (std::vector<glm::vec2> const& points, RunContext const* context) {
+
+        AdvancingFront::Result result;
+        std::vector<std::uint32_t>& indices = result.indices;
+
+        // Sweeping the distinct points only; duplicates get the smallest index of their position at the end.
+        PointSnapper::Result distinct = PointSnapper::snap(points);
+        std::vector<glm::vec2> const& coordinates = distinct.points;
+        std::size_t point_count = coordinates.size();
+        std::vector<std::uint32_t> first_indices(point_count, no_point);
+
+        for (std::size_t i = 0; i < points.size(); i++) {
+
+            if (first_indices[distinct.remap[i]] == no_point) first_indices[distinct.remap[i]] = static_cast<std::uint32_t>(i);
+
+        }
+
+        if (point_count < 3) return result;
+
+        auto get_point = [&coordinates] (std::uint32_t index) { return glm::dvec2(coordinates[index]); };
+
+        // Seed triangle: the point closest to the centre of the bounding box, its nearest neighbour, and the point making the smallest circumcircle with them.
+        glm::vec2 min_corner = coordinates[0], max_corner = coordinates[0];
+        for (auto const& point : coordinates) {
+
+            min_corner = glm::min(min_corner, point);
+            max_corner = glm::max(max_corner, point);
+
+        }
+
+        glm::dvec2 box_center = (glm::dvec2(min_corner) + glm::dvec2(max_corner)) / 2.0;
+        std::uint32_t seed0 = no_point, seed1 = no_point, seed2 = no_point;
+        double min_distance = std::numeric_limits<double>::infinity();
+
+        for (std::uint32_t i = 0; i < point_count; i++) {
+
+            double distance = squared_length(get_point(i) - box_center);
+            if (distance < min_distance) { min_distance = distance; seed0 = i; }
+
+        }
+
+        min_distance = std::numeric_limits<double>::infinity();
+        for (std::uint32_t i = 0; i < point_count; i++) {
+
+            double distance = squared_length(get_point(i) - get_point(seed0));
+            if (i != seed0 && distance < min_distance) { min_distance = distance; seed1 = i; }
+
+        }
+
+        double min_radius = std::numeric_limits<double>::infinity();
+        for (std::uint32_t i = 0; i < point_count; i++) {
+
+            if (i == seed0 || i == seed1) continue;
+
+            double radius = squared_length(get_circumcenter_offset(get_point(seed0), get_point(seed1), get_point(i)));
+            if (radius < min_radius) { min_radius = radius; seed2 = i; }
+
+        }
+
+        // Every point is collinear: there is no triangle.
+        if (seed2 == no_point) return result;
+
+        if (orientation(get_point(seed0), get_point(seed1), get_point(seed2)) < 0.0) std::swap(seed1, seed2);
+
+        glm::dvec2 center = get_point(seed0) + get_circumcenter_offset(get_point(seed0), get_point(seed1), get_point(seed2));
+        std::vector<std::uint32_t> order;
+        std::vector<double> distances(point_count);
+
+        order.reserve(point_count);
+        for (std::uint32_t i = 0; i < point_count; i++) {
+
+            distances[i] = squared_length(get_point(i) - center);
+            if (i != seed0 && i != seed1 && i != seed2) order.push_back(i);
+
+        }
+        std::sort(order.begin(), order.end(), [&distances] (std::uint32_t a, std::uint32_t b) {
+
+            return distances[a] < distances[b] || (distances[a] == distances[b] && a < b);
+
+        });
+
+        // Counterclockwise hull as a circular linked list (removed points have no next), with hull points hashed by their angle around
+        // the center. hull_edges[v] is the half-edge from v to the next hull point, which has no twin.
+        std::vector<std::uint32_t> hull_next(point_count, no_point), hull_previous(point_count, no_point), hull_edges(point_count, no_point);
+        std::size_t hash_size = static_cast<std::size_t>(std::ceil(std::sqrt(static_cast<double>(point_count))));
+        std::vector<std::uint32_t> hull_hash(hash_size, no_point);
+        std::uint32_t hull_start = seed0;
+
+        auto get_hash_key = [&] (glm::dvec2 point) {
+
+            return static_cast<std::size_t>(std::floor(SweepHull::get_pseudo_angle(point.x - center.x, point.y - center.y) * hash_size)) % hash_size;
+
+        };
+
+        // Half-edge h goes from indices[h] to the next corner of its triangle, twins[h] is the opposite half-edge.
+        std::vector<std::uint32_t> twins;
+        std::vector<std::uint32_t> edge_stack;
+
+        auto link = [&twins] (std::uint32_t a, std::uint32_t b) {
+
+            twins[a] = b;
+            if (b != no_point) twins[b] = a;
+
+        };
+
+        auto add_triangle = [&] (std::uint32_t v1, std::uint32_t v2, std::uint32_t v3, std::uint32_t twin1, std::uint32_t twin2, std::uint32_t twin3) {
+
+            std::uint32_t t = static_cast<std::uint32_t>(indices.size());
+
+            indices.insert(indices.end(), {v1, v2, v3});
+            twins.insert(twins.end(), {no_point, no_point, no_point});
+            link(t, twin1);
+            link(t + 1, twin2);
+            link(t + 2, twin3);
+            return t;
+
+        };
+
+        // Flips the edge h while it is not Delaunay, then the two edges it uncovers (Lawson), keeping hull_edges up to date.
+        auto legalize = [&] (std::uint32_t h) {
+
+            edge_stack.clear();
+            edge_stack.push_back(h);
+
+            while (!edge_stack.empty()) {
+
+                std::uint32_t a = edge_stack.back(), b = twins[a];
+
+                edge_stack.pop_back();
+                if (b == no_point) continue;
+
+                // Triangle (right, left, opposite) on a, (left, right, other) on b.
+                std::uint32_t
+                    a_next = a - a % 3 + (a + 1) % 3,
+                    a_previous = a - a % 3 + (a + 2) % 3,
+                    b_next = b - b % 3 + (b + 1) % 3,
+                    b_previous = b - b % 3 + (b + 2) % 3,
+                    right = indices[a],
+                    left = indices[a_next],
+                    opposite = indices[a_previous],
+                    other = indices[b_previous];
+
+                if (!is_in_circle(get_point(right), get_point(left), get_point(opposite), get_point(other))) continue;
+
+                // The triangles become (other, left, opposite) and (opposite, right, other).
+                std::uint32_t
+                    b_previous_twin = twins[b_previous],
+                    a_previous_twin = twins[a_previous];
+
+                indices[a] = other;
+                indices[b] = opposite;
+                link(a, b_previous_twin);
+                link(b, a_previous_twin);
+                link(a_previous, b_previous);
+
+                if (b_previous_twin == no_point && hull_edges[other] == b_previous) hull_edges[other] = a;
+                if (a_previous_twin == no_point && hull_edges[opposite] == a_previous) hull_edges[opposite] = b;
+
+                edge_stack.push_back(b_next);
+                edge_stack.push_back(a);
+
+            }
+
+        };
+
+        indices.reserve(6 * point_count);
+        twins.reserve(6 * point_count);
+
+        std::uint32_t seed_triangle = add_triangle(seed0, seed1, seed2, no_point, no_point, no_point);
+        hull_next[seed0] = seed1;
+        hull_next[seed1] = seed2;
+        hull_next[seed2] = seed0;
+        hull_previous[seed0] = seed2;
+        hull_previous[seed1] = seed0;
+        hull_previous[seed2] = seed1;
+        hull_edges[seed0] = seed_triangle;
+        hull_edges[seed1] = seed_triangle + 1;
+        hull_edges[seed2] = seed_triangle + 2;
+        for (auto const& seed : {seed0, seed1, seed2}) {
+
+            hull_hash[get_hash_key(get_point(seed))] = seed;
+
+        }
+
+        for (std::size_t k = 0; k < order.size(); k++) {
+
+            if (context != nullptr && k % 1024 == 0) {
+
+                result.stop_reason = context->get_stop_reason();
+                if (result.stop_reason != RunContext::NOT_STOPPED) break;
+
+            }
+
+            std::uint32_t i = order[k], start = no_point, edge;
+            glm::dvec2 point = get_point(i);
+            std::size_t key = get_hash_key(point);
+
+            // A hull point in about the direction of the new point, then the first hull edge (edge, next) it sees, on its right.
+            for (std::size_t j = 0; j < hash_size; j++) {
+
+                start = hull_hash[(key + j) % hash_size];
+                if (start != no_point && hull_next[start] != no_point) break;
+
+            }
+
+            start = hull_previous[start];
+            edge = start;
+            while (orientation(get_point(edge), get_point(hull_next[edge]), point) >= 0.0) {
+
+                edge = hull_next[edge];
+                if (edge == start) {
+
+                    edge = no_point;
+                    break;
+
+                }
+
+            }
+
+            // Only possible through rounding, since the point is farther from the center than the hull points around it.
+            if (edge == no_point) continue;
+
+            std::uint32_t next = hull_next[edge];
+            std::uint32_t t = add_triangle(edge, i, next, no_point, no_point, hull_edges[edge]);
+
+            hull_edges[i] = t + 1;
+            hull_edges[edge] = t;
+            legalize(t + 2);
+
+            // Adding the triangles of the following visible edges, whose shared points leave the hull.
+            while (orientation(get_point(next), get_point(hull_next[next]), point) < 0.0) {
+
+                std::uint32_t following = hull_next[next];
+
+                t = add_triangle(next, i, following, hull_edges[i], no_point, hull_edges[next]);
+                hull_edges[i] = t + 1;
+                legalize(t + 2);
+                hull_next[next] = no_point;
+                next = following;
+
+            }
+
+            // And of the previous ones, when the first visible edge was found right away.
+            if (edge == start) {
+
+                while (orientation(get_point(hull_previous[edge]), get_point(edge), point) < 0.0) {
+
+                    std::uint32_t previous = hull_previous[edge];
+
+                    t = add_triangle(previous, i, edge, no_point, hull_edges[edge], hull_edges[previous]);
+                    hull_edges[previous] = t;
+                    legalize(t + 2);
+                    hull_next[edge] = no_point;
+                    edge = previous;
+
+                }
+
+            }
+
+            hull_previous[i] = edge;
+            hull_next[i] = next;
+            hull_next[edge] = i;
+            hull_previous[next] = i;
+            hull_hash[key] = i;
+            hull_hash[get_hash_key(get_point(edge))] = edge;
+            hull_start = edge;
+
+        }
+
+        result.is_partial = result.stop_reason != RunContext::NOT_STOPPED;
+
+        if (result.is_partial) {
+
+            std::uint32_t vertex = hull_start;
+            do {
+
+                result.frontier.push_back(first_indices[vertex]);
+                result.frontier.push_back(first_indices[hull_next[vertex]]);
+                vertex = hull_next[vertex];
+
+            } while (vertex != hull_start);
+
+        }
+
+        for (auto& index : indices) {
+
+            index = first_indices[index];
+
+        }
+
+        return result;
+
+    }
+
+    std::vector<std::uint32_t> SweepHull::compute_triangulation_indices (std::vector<glm::vec2> const& points) {
+
+        return SweepHull::triangulate(points, nullptr).indices;
+
+    }
+
+    AdvancingFront::Result SweepHull::compute_triangulation_indices (std::vector<glm::vec2> const& points, RunContext const& context) {
+
+        return SweepHull::triangulate(points, &context);
+
+    }
+
+}
@@ -0,0 +1,39 @@
+#ifndef TRIANGULATION_SWEEPHULL_HPP
+#define TRIANGULATION_SWEEPHULL_HPP
+
+#include <vector>
+#include <cstdint>
+#include <glm/vec2.hpp>
+#include "AdvancingFront.hpp"
+#include "RunContext.hpp"
+
+namespace triangulation {
+
+    // Radial sweep-hull (S-hull) triangulation in O(n log n): starting from the seed triangle with the smallest circumcircle around
+    // the centre of the points, the points are added by increasing distance from its circumcenter, each one joined to the part of
+    // the current convex hull it sees, which is kept as a linked list with an angular hash to find that part quickly.
+    // Each new triangle is made Delaunay right away by flipping the edges facing the new point, so the result is a Delaunay
+    // triangulation of every input point, with triangles counterclockwise and duplicated points sharing their smallest index.
+    // AdvancingFront only gives the same triangles for points in general position: with points on the convex hull edges
+    // (grids, ...) its frontier spans them, leaving them out and its triangles not Delaunay.
+    class SweepHull {
+
+        private:
+
+            // Monotonic in the angle of the direction, in [0, 1), cheaper than atan2.
+            static double get_pseudo_angle (double dx, double dy);
+
+            static AdvancingFront::Result triangulate (std::vector<glm::vec2> const& points, RunContext const* context);
+
+        public:
+
+            static std::vector<std::uint32_t> compute_triangulation_indices (std::vector<glm::vec2> const& points);
+
+            // Stops early when the context says so, with the Delaunay triangulation of the points swept so far and its hull as frontier.
+            static AdvancingFront::Result compute_triangulation_indices (std::vector<glm::vec2> const& points, RunContext const& context);
+
+    };
+
+}
+
+#endif
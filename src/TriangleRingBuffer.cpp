@@ -0,0 +1,58 @@
+#include "TriangleRingBuffer.hpp"
+#include <algorithm>
+
+namespace triangulation {
+
+    TriangleRingBuffer::TriangleRingBuffer (std::size_t _capacity) : capacity(std::max<std::size_t>(1, _capacity)), pushed(0), popped(0), closed(false) {
+
+        this->slots.resize(3 * this->capacity);
+
+    }
+
+    void TriangleRingBuffer::operator () (std::uint32_t vertex1, std::uint32_t vertex2, std::uint32_t vertex3) {
+
+        std::unique_lock<std::mutex> lock(this->mutex);
+        this->not_full.wait(lock, [this] () { return this->pushed - this->popped < this->capacity; });
+
+        std::size_t slot = 3 * (this->pushed % this->capacity);
+        this->slots[slot] = vertex1;
+        this->slots[slot + 1] = vertex2;
+        this->slots[slot + 2] = vertex3;
+
+        // Only the first triangle after the buffer went empty can have a consumer waiting for it.
+        if (this->pushed++ == this->popped) this->not_empty.notify_one();
+
+    }
+
+    void TriangleRingBuffer::close () {
+
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->closed = true;
+        this->not_empty.notify_all();
+
+    }
+
+    std::size_t TriangleRingBuffer::pop (std::vector<std::uint32_t>& indices, std::size_t max_count) {
+
+        std::unique_lock<std::mutex> lock(this->mutex);
+        this->not_empty.wait(lock, [this] () { return this->closed || this->pushed != this->popped; });
+
+        // Popping nothing from a buffer that is not empty would look like the end to the consumer, and leave the producer blocked.
+        std::size_t count = std::min(std::max<std::size_t>(1, max_count), this->pushed - this->popped);
+        bool was_full = this->pushed - this->popped == this->capacity;
+
+        for (std::size_t i = 0; i < count; i++) {
+
+            std::size_t slot = 3 * ((this->popped + i) % this->capacity);
+            indices.insert(indices.end(), this->slots.begin() + slot, this->slots.begin() + slot + 3);
+
+        }
+        this->popped += count;
+
+        if (was_full && count > 0) this->not_full.notify_one();
+
+        return count;
+
+    }
+
+}
@@ -0,0 +1,49 @@
+#ifndef TRIANGULATION_TRIANGLERINGBUFFER_HPP
+#define TRIANGULATION_TRIANGLERINGBUFFER_HPP
+
+#include <vector>
+#include <cstdint>
+#include <mutex>
+#include <condition_variable>
+
+namespace triangulation {
+
+    // Bounded queue of triangles between one producer, usually an AdvancingFront run using it as its sink, and one consumer
+    // (a writer, a GPU upload, ...) on another thread, so that consuming overlaps with computing.
+    // The producer blocks while the buffer is full, so memory stays bounded whatever the size of the triangulation.
+    class TriangleRingBuffer {
+
+        private:
+
+            std::vector<std::uint32_t> slots;
+            std::size_t capacity;
+            // Triangles pushed and popped so far; the buffer holds those in between.
+            std::size_t pushed, popped;
+            bool closed;
+            std::mutex mutex;
+            std::condition_variable not_full;
+            std::condition_variable not_empty;
+
+        public:
+
+            // Holds at most capacity triangles.
+            TriangleRingBuffer (std::size_t _capacity = 4096);
+
+            TriangleRingBuffer (TriangleRingBuffer const&) = delete;
+            TriangleRingBuffer& operator = (TriangleRingBuffer const&) = delete;
+
+            // Pushes a triangle, waiting while the buffer is full (the sink interface).
+            void operator () (std::uint32_t vertex1, std::uint32_t vertex2, std::uint32_t vertex3);
+
+            // Called by the producer once every triangle has been pushed.
+            void close ();
+
+            // Waits for triangles, then appends up to max_count of them (at least 1, also when max_count is 0) to indices and
+            // returns their count. Returns 0 only once the buffer is closed and empty.
+            std::size_t pop (std::vector<std::uint32_t>& indices, std::size_t max_count);
+
+    };
+
+}
+
+#endif
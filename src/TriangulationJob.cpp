@@ -0,0 +1,311 @@
+#include "TriangulationJob.hpp"
+#include "SweepHull.hpp"
+#include "PointDecimator.hpp"
+#include <memory>
+
+namespace triangulation {
+
+    glm::vec2 TriangulationJob::Task::get_point (std::uint32_t index) const {
+
+        return this->is_compact ? this->compact_points[index] : this->points[index];
+
+    }
+
+    TriangulationJob::TriangulationJob () : stitch_first_task(false), preview_resolution(0), preview_budget(0), preview_ready(false), cancel_requested(false), run_context(&this->cancel_requested), running(false) {}
+
+    TriangulationJob::~TriangulationJob () {
+
+        this->cancel();
+        this->wait();
+
+    }
+
+    void TriangulationJob::start (std::vector<std::vector<glm::vec2>> point_sets, unsigned int quantization_bits, std::vector<std::vector<glm::vec2>> hulls, bool stitch_first, std::vector<std::uint32_t> _stitch_remap) {
+
+        // Stopping any previous job before replacing its tasks.
+        this->cancel();
+        this->wait();
+
+        this->tasks.clear();
+        this->tasks.resize(point_sets.size());
+        for (std::size_t i = 0; i < point_sets.size(); ++i) {
+
+            if (quantization_bits > 0) {
+
+                this->tasks[i].compact_points = CompactPoints(point_sets[i], quantization_bits);
+                this->tasks[i].is_compact = true;
+                // Releasing each set once quantized, so that the sets are not all held twice.
+                std::vector<glm::vec2>().swap(point_sets[i]);
+
+            } else {
+
+                this->tasks[i].points = std::move(point_sets[i]);
+                if (i < hulls.size()) this->tasks[i].hull = std::move(hulls[i]);
+
+            }
+
+        }
+
+        this->stitch_first_task = stitch_first && quantization_bits == 0;
+        this->stitch_remap = std::move(_stitch_remap);
+        this->preview_points.clear();
+        this->preview = AdvancingFront::Result();
+        this->preview_ready = false;
+        this->cancel_requested = false;
+        this->running = true;
+        this->worker = std::thread(&TriangulationJob::run, this);
+
+    }
+
+    void TriangulationJob::run () {
+
+        std::unique_ptr<Stitcher> stitcher;
+
+        this->run_preview();
+
+        // When stitching, the first task is built from the triangulations of the others as they finish.
+        if (this->stitch_first_task && !this->tasks.empty()) {
+
+            std::vector<std::vector<glm::vec2>> groups;
+
+            for (std::size_t i = 1; i < this->tasks.size(); ++i) {
+
+                groups.push_back(this->tasks[i].points);
+
+            }
+            stitcher = std::make_unique<Stitcher>(groups);
+
+        }
+
+        for (std::size_t i = (stitcher != nullptr) ? 1 : 0; i < this->tasks.size(); ++i) {
+
+            this->run_task(this->tasks[i]);
+
+            // The worker thread is the only one writing the task indices, so they can be read without the lock.
+            if (stitcher != nullptr && !this->cancel_requested) {
+
+                stitcher->add_group(i - 1, this->tasks[i].indices);
+                this->publish_stitched(*stitcher);
+
+            }
+
+        }
+
+        if (stitcher != nullptr) {
+
+            if (!this->cancel_requested) {
+
+                stitcher->finish();
+                this->publish_stitched(*stitcher);
+
+            }
+
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->tasks[0].finished = true;
+
+        }
+
+        this->running = false;
+
+    }
+
+    void TriangulationJob::run_preview () {
+
+        if (this->preview_resolution == 0 || this->tasks.empty() || this->cancel_requested) return;
+
+        Task const& task = this->tasks[0];
+        std::size_t point_count = task.is_compact ? task.compact_points.size() : task.points.size();
+
+        // The preview is only worth it when decimation drops points.
+        if (point_count <= this->preview_resolution * this->preview_resolution) return;
+
+        std::vector<glm::vec2> dequantized_points;
+        if (task.is_compact) {
+
+            dequantized_points.reserve(point_count);
+            for (std::uint32_t i = 0; i < point_count; ++i) {
+
+                dequantized_points.push_back(task.compact_points[i]);
+
+            }
+
+        }
+
+        PointDecimator::Result decimated = PointDecimator::decimate(task.is_compact ? dequantized_points : task.points, this->preview_resolution);
+        RunContext preview_context(&this->cancel_requested);
+
+        preview_context.set_time_budget(this->preview_budget);
+        AdvancingFront::Result result = SweepHull::compute_triangulation_indices(decimated.points, preview_context);
+
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->preview_points = std::move(decimated.points);
+        this->preview = std::move(result);
+        this->preview_ready = true;
+
+    }
+
+    void TriangulationJob::run_task (Task& task) {
+
+        if (!this->cancel_requested) {
+
+            AdvancingFront::Observer observer;
+
+            observer.context = &this->run_context;
+            observer.on_triangle = [this, &task] (std::uint32_t v1, std::uint32_t v2, std::uint32_t v3) {
+
+                std::lock_guard<std::mutex> lock(this->mutex);
+
+                task.indices.push_back(v1);
+                task.indices.push_back(v2);
+                task.indices.push_back(v3);
+
+            };
+            observer.on_frontier = [this, &task] (std::vector<std::uint32_t> const& edges) {
+
+                std::vector<glm::vec2> frontier;
+
+                frontier.reserve(edges.size());
+                for (auto const& index : edges) {
+
+                    frontier.push_back(task.get_point(index));
+
+                }
+
+                std::lock_guard<std::mutex> lock(this->mutex);
+                task.frontier = std::move(frontier);
+                task.frontier_changed = true;
+
+            };
+
+            if (task.is_compact) {
+
+                AdvancingFront::compute_triangulation_indices(task.compact_points, observer);
+
+            } else if (!task.hull.empty()) {
+
+                AdvancingFront::compute_triangulation_indices(task.points, task.hull, observer);
+
+            } else {
+
+                AdvancingFront::compute_triangulation_indices(task.points, observer);
+
+            }
+
+        }
+
+        std::lock_guard<std::mutex> lock(this->mutex);
+        task.finished = true;
+
+    }
+
+    void TriangulationJob::publish_stitched (Stitcher const& stitcher) {
+
+        Task& task = this->tasks[0];
+        std::vector<std::uint32_t> const& stitched = stitcher.get_indices();
+        std::vector<std::uint32_t> indices(stitched.begin() + task.indices.size(), stitched.end());
+
+        if (!this->stitch_remap.empty()) {
+
+            for (auto& index : indices) {
+
+                index = this->stitch_remap[index];
+
+            }
+
+        }
+
+        std::lock_guard<std::mutex> lock(this->mutex);
+        task.indices.insert(task.indices.end(), indices.begin(), indices.end());
+
+    }
+
+    void TriangulationJob::set_preview (std::size_t resolution, std::chrono::milliseconds time_budget) {
+
+        this->preview_resolution = resolution;
+        this->preview_budget = time_budget;
+
+    }
+
+    void TriangulationJob::cancel () {
+
+        this->cancel_requested = true;
+
+    }
+
+    void TriangulationJob::wait () {
+
+        if (this->worker.joinable()) this->worker.join();
+
+    }
+
+    bool TriangulationJob::is_running () const {
+
+        return this->running;
+
+    }
+
+    bool TriangulationJob::is_cancelled () const {
+
+        return this->cancel_requested;
+
+    }
+
+    std::size_t TriangulationJob::get_task_count () const {
+
+        return this->tasks.size();
+
+    }
+
+    float TriangulationJob::get_quantization_error (std::size_t task) const {
+
+        return this->tasks[task].is_compact ? this->tasks[task].compact_points.get_max_error() : 0.0f;
+
+    }
+
+    bool TriangulationJob::is_finished (std::size_t task) {
+
+        std::lock_guard<std::mutex> lock(this->mutex);
+        return this->tasks[task].finished;
+
+    }
+
+    bool TriangulationJob::fetch (std::size_t task, std::vector<std::uint32_t>& indices, std::vector<glm::vec2>& frontier) {
+
+        std::lock_guard<std::mutex> lock(this->mutex);
+        Task& t = this->tasks[task];
+        bool changed = false;
+
+        if (indices.size() < t.indices.size()) {
+
+            indices.insert(indices.end(), t.indices.begin() + indices.size(), t.indices.end());
+            changed = true;
+
+        }
+
+        if (t.frontier_changed) {
+
+            frontier = t.frontier;
+            t.frontier_changed = false;
+            changed = true;
+
+        }
+
+        return changed;
+
+    }
+
+    bool TriangulationJob::fetch_preview (std::vector<glm::vec2>& points, AdvancingFront::Result& result) {
+
+        std::lock_guard<std::mutex> lock(this->mutex);
+
+        if (!this->preview_ready) return false;
+
+        points = std::move(this->preview_points);
+        result = std::move(this->preview);
+        this->preview_ready = false;
+
+        return true;
+
+    }
+
+}
@@ -0,0 +1,113 @@
+#ifndef TRIANGULATION_TRIANGULATIONJOB_HPP
+#define TRIANGULATION_TRIANGULATIONJOB_HPP
+
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <glm/vec2.hpp>
+#include "CompactPoints.hpp"
+#include "RunContext.hpp"
+#include "Stitcher.hpp"
+#include "AdvancingFront.hpp"
+
+namespace triangulation {
+
+    // Runs a list of AdvancingFront triangulations on a worker thread, after an optional quick preview of the first point set.
+    // Partial results (triangles emitted so far and the current frontier) can be fetched at any time while the job runs.
+    class TriangulationJob {
+
+        private:
+
+            struct Task {
+
+                std::vector<glm::vec2> points;
+                // Convex hull of the points if it is already known, or empty.
+                std::vector<glm::vec2> hull;
+                CompactPoints compact_points;
+                bool is_compact = false;
+
+                // Guarded by the job mutex.
+                std::vector<std::uint32_t> indices;
+                std::vector<glm::vec2> frontier;
+                bool frontier_changed = false;
+                bool finished = false;
+
+                glm::vec2 get_point (std::uint32_t index) const;
+
+            };
+
+            std::vector<Task> tasks;
+            bool stitch_first_task;
+            std::size_t preview_resolution;
+            std::chrono::milliseconds preview_budget;
+            // Guarded by the job mutex.
+            std::vector<glm::vec2> preview_points;
+            AdvancingFront::Result preview;
+            bool preview_ready;
+            std::vector<std::uint32_t> stitch_remap;
+            std::mutex mutex;
+            std::thread worker;
+            std::atomic<bool> cancel_requested;
+            // Stops the triangulations when cancel_requested is set.
+            RunContext run_context;
+            std::atomic<bool> running;
+
+            void run ();
+            void run_preview ();
+            void run_task (Task& task);
+
+            // Appends to the first task the triangles the stitcher added since the last call.
+            void publish_stitched (Stitcher const& stitcher);
+
+        public:
+
+            TriangulationJob ();
+            ~TriangulationJob ();
+
+            TriangulationJob (TriangulationJob const&) = delete;
+            TriangulationJob& operator = (TriangulationJob const&) = delete;
+
+            // Starts triangulating each point set, in order, on the worker thread.
+            // If quantization_bits is not 0, the points are stored as CompactPoints with that precision.
+            // The convex hulls of the point sets can be given to skip computing them again (they are not used with quantized points).
+            // If stitch_first is set, the first point set must be the concatenation of the others: it is triangulated by stitching
+            // their triangulations together (not with quantized points), streaming the triangles kept from each one once it is
+            // done and those filling the gaps between them at the end.
+            // The first point set can also be the concatenation with duplicates merged (PointSnapper), stitch_remap mapping each concatenated point to it.
+            void start (std::vector<std::vector<glm::vec2>> point_sets, unsigned int quantization_bits = 0, std::vector<std::vector<glm::vec2>> hulls = {}, bool stitch_first = false, std::vector<std::uint32_t> stitch_remap = {});
+
+            // Makes the next jobs start with a SweepHull triangulation of the first point set decimated to a grid of resolution
+            // cells along its longer side (PointDecimator), stopped after time_budget. There is no preview when resolution is 0
+            // or when the decimation would keep every point.
+            void set_preview (std::size_t resolution, std::chrono::milliseconds time_budget);
+
+            // Asks the running triangulation to stop; the triangles found so far are kept.
+            void cancel ();
+
+            // Waits for the worker thread to finish.
+            void wait ();
+
+            bool is_running () const;
+            bool is_cancelled () const;
+
+            std::size_t get_task_count () const;
+
+            // Largest quantization error of the task points (0 if they are not quantized).
+            float get_quantization_error (std::size_t task) const;
+            bool is_finished (std::size_t task);
+
+            // Appends to indices the triangles (three indices into the task points) produced since the last call,
+            // and replaces frontier (pairs of points) if it changed. Returns true if anything was updated.
+            bool fetch (std::size_t task, std::vector<std::uint32_t>& indices, std::vector<glm::vec2>& frontier);
+
+            // Moves the preview out once it is done: its points, and its triangles indexing them (partial if the time budget ran out).
+            // Returns true only that once.
+            bool fetch_preview (std::vector<glm::vec2>& points, AdvancingFront::Result& result);
+
+    };
+
+}
+
+#endif
@@ -0,0 +1,512 @@
+#include "TriangulationService.hpp"
+#include "AdvancingFront.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace triangulation {
+
+    namespace {
+
+        std::chrono::seconds const stop_grace_period(1);
+
+    }
+
+    TriangulationService::Connection::Connection (int _input_fd, int _output_fd, bool _owns_fds) : input_fd(_input_fd), output_fd(_output_fd), owns_fds(_owns_fds) {}
+
+    TriangulationService::Connection::~Connection () {
+
+        if (this->owns_fds) {
+
+            ::close(this->input_fd);
+            if (this->output_fd != this->input_fd) ::close(this->output_fd);
+
+        }
+
+    }
+
+    void TriangulationService::Connection::write (std::string const& response) {
+
+        {
+
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->responses.push_back(response);
+
+        }
+        this->changed.notify_all();
+
+    }
+
+    void TriangulationService::Connection::run_writer () {
+
+        std::unique_lock<std::mutex> lock(this->mutex);
+
+        while (true) {
+
+            this->changed.wait(lock, [this] () { return this->closing || !this->responses.empty(); });
+            if (this->responses.empty()) return;
+
+            std::string response = std::move(this->responses.front());
+            std::size_t written = 0;
+
+            this->responses.pop_front();
+            lock.unlock();
+
+            // A client that went away only loses its responses.
+            while (written < response.size()) {
+
+                ssize_t count = ::write(this->output_fd, response.data() + written, response.size() - written);
+
+                if (count < 0 && errno == EINTR) continue;
+                if (count <= 0) break;
+                written += count;
+
+            }
+
+            lock.lock();
+            this->pending--;
+            this->changed.notify_all();
+
+        }
+
+    }
+
+    void TriangulationService::Connection::close () {
+
+        {
+
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->closing = true;
+
+        }
+        this->changed.notify_all();
+
+    }
+
+    TriangulationService::TriangulationService (unsigned int worker_count, std::size_t _queue_capacity, std::chrono::milliseconds _time_budget, std::size_t _max_point_count) :
+        queue_capacity(std::max<std::size_t>(1, _queue_capacity)), max_point_count(_max_point_count), time_budget(_time_budget), stopping_workers(false), stop_requested(false), listen_fd(-1) {
+
+        if (pipe(this->wake_fds) < 0) throw std::runtime_error("Error: Failed to create the service wake pipe!");
+
+        // Neither stop() nor draining the pipe may block.
+        fcntl(this->wake_fds[0], F_SETFL, O_NONBLOCK);
+        fcntl(this->wake_fds[1], F_SETFL, O_NONBLOCK);
+
+        if (worker_count == 0) worker_count = std::max(1u, std::thread::hardware_concurrency());
+
+        for (unsigned int i = 0; i < worker_count; i++) {
+
+            this->workers.emplace_back(&TriangulationService::run_worker, this);
+
+        }
+
+    }
+
+    TriangulationService::~TriangulationService () {
+
+        this->stop();
+
+        {
+
+            std::lock_guard<std::mutex> lock(this->queue_mutex);
+            this->stopping_workers = true;
+
+        }
+        this->queue_not_empty.notify_all();
+
+        for (auto& worker : this->workers) {
+
+            worker.join();
+
+        }
+
+        close(this->wake_fds[0]);
+        close(this->wake_fds[1]);
+
+    }
+
+    void TriangulationService::run_worker () {
+
+        Arena arena;
+
+        while (true) {
+
+            Request request;
+
+            {
+
+                std::unique_lock<std::mutex> lock(this->queue_mutex);
+
+                this->queue_not_empty.wait(lock, [this] () { return this->stopping_workers || !this->queue.empty(); });
+                if (this->queue.empty()) return;
+
+                request = std::move(this->queue.front());
+                this->queue.pop_front();
+
+            }
+            this->queue_not_full.notify_one();
+
+            // The connection's writer counts the request as answered once its response is written.
+            this->process(request, arena);
+
+        }
+
+    }
+
+    void TriangulationService::submit (Request request) {
+
+        {
+
+            std::unique_lock<std::mutex> lock(request.connection->mutex);
+            Connection& connection = *request.connection;
+
+            connection.changed.wait(lock, [this, &connection] () { return connection.pending < this->queue_capacity; });
+            connection.pending++;
+
+        }
+
+        {
+
+            std::unique_lock<std::mutex> lock(this->queue_mutex);
+
+            this->queue_not_full.wait(lock, [this] () { return this->queue.size() < this->queue_capacity; });
+            this->queue.push_back(std::move(request));
+
+        }
+        this->queue_not_empty.notify_one();
+
+    }
+
+    void TriangulationService::read_requests (std::shared_ptr<Connection> connection) {
+
+        std::string buffer, line;
+        char chunk[1 << 16];
+        std::thread writer(&Connection::run_writer, connection.get());
+
+        // Reading stops while the queue is full, so a busy service pushes back on its clients through their stream.
+        while (!this->stop_requested) {
+
+            pollfd fds[2] = {{connection->input_fd, POLLIN, 0}, {this->wake_fds[0], POLLIN, 0}};
+
+            if (poll(fds, 2, -1) < 0) {
+
+                if (errno == EINTR) continue;
+                break;
+
+            }
+            if (fds[1].revents != 0) break;
+
+            ssize_t count = read(connection->input_fd, chunk, sizeof(chunk));
+
+            if (count < 0 && errno == EINTR) continue;
+            if (count <= 0) break;
+
+            buffer.append(chunk, count);
+
+            std::size_t line_start = 0, line_end;
+            while ((line_end = buffer.find('\n', line_start)) != std::string::npos) {
+
+                line.assign(buffer, line_start, line_end - line_start);
+                line_start = line_end + 1;
+
+                if (line.find_first_not_of(" \t\r") != std::string::npos) this->submit({connection, std::move(line)});
+
+            }
+            buffer.erase(0, line_start);
+
+        }
+
+        if (!this->stop_requested && buffer.find_first_not_of(" \t\r") != std::string::npos) this->submit({connection, std::move(buffer)});
+
+        {
+
+            std::unique_lock<std::mutex> lock(connection->mutex);
+            connection->changed.wait(lock, [&connection] () { return connection->pending == 0; });
+
+        }
+        connection->close();
+        writer.join();
+
+    }
+
+    void TriangulationService::process (Request const& request, Arena& arena) const {
+
+        char const* cursor = request.line.c_str();
+        char* end;
+        std::string id, command;
+
+        auto next_token = [&cursor] () {
+
+            while (*cursor == ' ' || *cursor == '\t') cursor++;
+            char const* start = cursor;
+            while (*cursor != '\0' && *cursor != ' ' && *cursor != '\t' && *cursor != '\r') cursor++;
+            return std::string(start, cursor);
+
+        };
+
+        id = next_token();
+        command = next_token();
+
+        try {
+
+            if (command == "points") {
+
+                unsigned long count = std::strtoul(cursor, &end, 10);
+
+                if (end == cursor) throw std::invalid_argument("missing point count");
+                cursor = end;
+                arena.points.clear();
+                if (count > this->max_point_count) throw std::invalid_argument(std::to_string(count) + " points, at most " + std::to_string(this->max_point_count) + " are accepted");
+                // The count comes from the client: reserving no more than the line can hold ("x y " takes 4 characters at least)
+                // keeps a short request from allocating for points it does not have.
+                arena.points.reserve(std::min<std::size_t>(count, request.line.size() / 4));
+                parse_inline_points(cursor, arena.points);
+                if (arena.points.size() != count) throw std::invalid_argument("expected " + std::to_string(count) + " points, got " + std::to_string(arena.points.size()));
+
+            } else if (command == "file") {
+
+                read_points_file(next_token(), this->max_point_count, arena.points);
+
+            } else {
+
+                throw std::invalid_argument("unknown command '" + command + "'");
+
+            }
+
+            // Requests in flight are cut short when the service stops.
+            RunContext context(&this->stop_requested);
+            if (this->time_budget.count() > 0) context.set_time_budget(this->time_budget);
+
+            AdvancingFront::Result result = AdvancingFront::compute_triangulation_indices(arena.points, context);
+            std::vector<std::uint32_t> const& indices = result.indices;
+            char number[16];
+
+            arena.response.clear();
+            arena.response.reserve(id.size() + 32 + indices.size() * 8);
+            arena.response += id;
+            arena.response += result.is_partial ? " partial " : " triangles ";
+            arena.response += std::to_string(indices.size() / 3);
+            for (auto const& index : indices) {
+
+                arena.response += ' ';
+                arena.response.append(number, std::to_chars(number, number + sizeof(number), index).ptr);
+
+            }
+            arena.response += '\n';
+
+        } catch (std::exception const& e) {
+
+            arena.response = id + " error " + e.what() + "\n";
+
+        }
+
+        request.connection->write(arena.response);
+
+    }
+
+    void TriangulationService::parse_inline_points (char const* cursor, std::vector<glm::vec2>& points) {
+
+        char* end;
+
+        while (true) {
+
+            float x = std::strtof(cursor, &end);
+            if (end == cursor) break;
+            cursor = end;
+
+            float y = std::strtof(cursor, &end);
+            if (end == cursor) throw std::invalid_argument("odd number of coordinates");
+            cursor = end;
+
+            points.emplace_back(x, y);
+
+        }
+
+    }
+
+    void TriangulationService::read_points_file (std::string const& path, std::size_t max_count, std::vector<glm::vec2>& points) {
+
+        int fd = open(path.c_str(), O_RDONLY);
+        struct stat file_stat;
+
+        if (fd < 0) throw std::runtime_error("cannot open " + path);
+        if (fstat(fd, &file_stat) < 0 || file_stat.st_size % (2 * sizeof(float)) != 0) {
+
+            close(fd);
+            throw std::runtime_error("invalid points file " + path);
+
+        }
+
+        std::size_t count = file_stat.st_size / (2 * sizeof(float));
+
+        if (count > max_count) {
+
+            close(fd);
+            throw std::invalid_argument(path + " holds " + std::to_string(count) + " points, at most " + std::to_string(max_count) + " are accepted");
+
+        }
+
+        points.resize(count);
+        if (count == 0) {
+
+            close(fd);
+            return;
+
+        }
+
+        // Mapping the file avoids copying it through a read buffer.
+        void* data = mmap(nullptr, file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (data == MAP_FAILED) throw std::runtime_error("cannot map " + path);
+
+        float const* coordinates = static_cast<float const*>(data);
+        for (std::size_t i = 0; i < count; i++) {
+
+            points[i] = glm::vec2(coordinates[2*i], coordinates[2*i + 1]);
+
+        }
+
+        munmap(data, file_stat.st_size);
+
+    }
+
+    void TriangulationService::serve_stream (int input_fd, int output_fd) {
+
+        this->read_requests(std::make_shared<Connection>(input_fd, output_fd, false));
+
+    }
+
+    void TriangulationService::serve_socket (std::string const& path) {
+
+        sockaddr_un address{};
+        int fd;
+
+        if (path.size() >= sizeof(address.sun_path)) throw std::invalid_argument("Error: Socket path too long: " + path);
+
+        // Writing to a client that disconnected must not kill the service.
+        std::signal(SIGPIPE, SIG_IGN);
+
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0) throw std::runtime_error("Error: Failed to create socket!");
+
+        address.sun_family = AF_UNIX;
+        std::strcpy(address.sun_path, path.c_str());
+        unlink(path.c_str());
+
+        if (bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0 || listen(fd, SOMAXCONN) < 0) {
+
+            close(fd);
+            throw std::runtime_error("Error: Failed to listen on socket " + path + "!");
+
+        }
+
+        // Forgetting an earlier stop(), whose bytes would wake the readers at once.
+        char wake_bytes[64];
+        while (read(this->wake_fds[0], wake_bytes, sizeof(wake_bytes)) > 0);
+
+        this->stop_requested = false;
+        this->listen_fd = fd;
+
+        std::vector<std::thread> readers;
+
+        while (!this->stop_requested) {
+
+            int client_fd = accept(fd, nullptr, nullptr);
+
+            if (client_fd < 0) {
+
+                if (errno == EINTR) continue;
+                break;
+
+            }
+
+            auto connection = std::make_shared<Connection>(client_fd, client_fd, true);
+
+            {
+
+                std::lock_guard<std::mutex> lock(this->readers_mutex);
+
+                // Joining the readers and forgetting the connections that are already closed.
+                for (auto const& id : this->finished_readers) {
+
+                    auto reader = std::find_if(readers.begin(), readers.end(), [&id] (std::thread const& thread) { return thread.get_id() == id; });
+                    reader->join();
+                    readers.erase(reader);
+
+                }
+                this->finished_readers.clear();
+                this->socket_connections.erase(std::remove_if(this->socket_connections.begin(), this->socket_connections.end(), [] (std::weak_ptr<Connection> const& c) { return c.expired(); }), this->socket_connections.end());
+                this->socket_connections.push_back(connection);
+
+            }
+
+            readers.emplace_back([this, connection] () {
+
+                this->read_requests(connection);
+
+                {
+
+                    std::lock_guard<std::mutex> lock(this->readers_mutex);
+                    this->finished_readers.push_back(std::this_thread::get_id());
+
+                }
+                this->reader_finished.notify_all();
+
+            });
+
+        }
+
+        // Waiting for the clients to be answered before removing the socket. A client that does not take its responses
+        // would block its writer forever: shutting its socket down makes the writes fail.
+        {
+
+            std::unique_lock<std::mutex> lock(this->readers_mutex);
+
+            this->reader_finished.wait_for(lock, stop_grace_period, [this, &readers] () { return this->finished_readers.size() == readers.size(); });
+            for (auto const& weak_connection : this->socket_connections) {
+
+                if (auto connection = weak_connection.lock()) shutdown(connection->output_fd, SHUT_RDWR);
+
+            }
+
+        }
+        for (auto& reader : readers) {
+
+            reader.join();
+
+        }
+        this->finished_readers.clear();
+        this->socket_connections.clear();
+
+        close(fd);
+        this->listen_fd = -1;
+        unlink(path.c_str());
+
+    }
+
+    void TriangulationService::stop () {
+
+        this->stop_requested = true;
+
+        // Waking the readers and unblocking accept(); requests already read are still answered. The write only fails when
+        // the pipe is full, which wakes the readers just as well.
+        char wake_byte = 0;
+        [[maybe_unused]] ssize_t written = ::write(this->wake_fds[1], &wake_byte, 1);
+
+        int fd = this->listen_fd;
+        if (fd >= 0) shutdown(fd, SHUT_RDWR);
+
+    }
+
+}
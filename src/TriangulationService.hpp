@@ -0,0 +1,131 @@
+#ifndef TRIANGULATION_TRIANGULATIONSERVICE_HPP
+#define TRIANGULATION_TRIANGULATIONSERVICE_HPP
+
+#include <vector>
+#include <deque>
+#include <string>
+#include <memory>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <glm/vec2.hpp>
+
+namespace triangulation {
+
+    // Long-running triangulation server answering requests from a stream (stdin/stdout) or a Unix domain socket.
+    // Requests and responses are single lines, answered as soon as they are done (not necessarily in order):
+    //   <id> points <n> <x1> <y1> ... <xn> <yn>   points given inline
+    //   <id> file <path>                          points read from a file of little-endian float32 x, y pairs
+    //   -> <id> triangles <count> <i1> <i2> <i3> ...   or   <id> error <message>
+    //   -> <id> partial <count> <i1> <i2> <i3> ...     when the time budget ran out (or the service stopped): the triangles found so far
+    // Warm workers keep their buffers between requests, and a bounded queue stops reading new requests while they are busy.
+    class TriangulationService {
+
+        private:
+
+            // Client side of a stream, closed once nothing refers to it anymore. Workers only queue their responses: a writer
+            // thread per connection writes them, so a client that reads slowly holds back its own responses and no worker.
+            struct Connection {
+
+                int input_fd;
+                int output_fd;
+                bool owns_fds;
+
+                // Responses not written yet, and requests read but not answered yet (queued, in progress or in responses).
+                std::deque<std::string> responses;
+                std::size_t pending = 0;
+                bool closing = false;
+                std::mutex mutex;
+                std::condition_variable changed;
+
+                Connection (int input_fd, int output_fd, bool owns_fds);
+                ~Connection ();
+
+                // Queues the response of a pending request.
+                void write (std::string const& response);
+
+                // Writes the queued responses until close() is called and none is left.
+                void run_writer ();
+                void close ();
+
+            };
+
+            struct Request {
+
+                std::shared_ptr<Connection> connection;
+                std::string line;
+
+            };
+
+            // Buffers a worker reuses from one request to the next.
+            struct Arena {
+
+                std::vector<glm::vec2> points;
+                std::string response;
+
+            };
+
+            std::size_t queue_capacity;
+            std::size_t max_point_count;
+            std::chrono::milliseconds time_budget;
+            std::deque<Request> queue;
+            std::mutex queue_mutex;
+            std::condition_variable queue_not_empty;
+            std::condition_variable queue_not_full;
+            bool stopping_workers;
+            std::vector<std::thread> workers;
+
+            std::atomic<bool> stop_requested;
+            std::atomic<int> listen_fd;
+            // stop() writes to this pipe to wake the readers, whichever kind of stream they read.
+            int wake_fds[2];
+            // Reader threads that are done and can be joined, and the socket clients to cut off if they stop reading.
+            std::vector<std::thread::id> finished_readers;
+            std::vector<std::weak_ptr<Connection>> socket_connections;
+            std::mutex readers_mutex;
+            std::condition_variable reader_finished;
+
+            void run_worker ();
+
+            // Reads requests from the connection until end of input or stop(), then waits for their responses to be written.
+            // Reading also pauses while queue_capacity responses of the connection are pending.
+            void read_requests (std::shared_ptr<Connection> connection);
+
+            // Blocks while the queue is full.
+            void submit (Request request);
+
+            void process (Request const& request, Arena& arena) const;
+
+            static void parse_inline_points (char const* cursor, std::vector<glm::vec2>& points);
+            // Throws if the file holds more than max_count points.
+            static void read_points_file (std::string const& path, std::size_t max_count, std::vector<glm::vec2>& points);
+
+        public:
+
+            // Starts worker_count worker threads (0 uses every hardware thread); at most queue_capacity requests wait for a worker.
+            // Each triangulation stops after time_budget (0 for no limit), counted from when a worker picks the request.
+            // Requests with more than max_point_count points are answered with an error before anything is allocated for them.
+            TriangulationService (unsigned int worker_count = 0, std::size_t queue_capacity = 64, std::chrono::milliseconds time_budget = std::chrono::milliseconds(0), std::size_t max_point_count = 1 << 24);
+            ~TriangulationService ();
+
+            TriangulationService (TriangulationService const&) = delete;
+            TriangulationService& operator = (TriangulationService const&) = delete;
+
+            // Serves requests read from input_fd, writing responses to output_fd, until end of input or stop().
+            void serve_stream (int input_fd, int output_fd);
+
+            // Listens on a Unix domain socket and serves every client concurrently, until stop() is called. Clients then have
+            // a second to take their last responses before they are disconnected.
+            void serve_socket (std::string const& path);
+
+            // Stops reading requests and cuts the ones in progress short; every request read is still answered.
+            // Safe to call from any thread, but not from a signal handler.
+            void stop ();
+
+    };
+
+}
+
+#endif
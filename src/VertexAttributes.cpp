@@ -0,0 +1,99 @@
+#include "VertexAttributes.hpp"
+#include <stdexcept>
+
+namespace triangulation {
+
+    std::size_t VertexAttributes::get_channel_count () const {
+
+        return this->channels.size();
+
+    }
+
+    std::size_t VertexAttributes::get_vertex_count () const {
+
+        return this->channels.empty() ? 0 : this->channels[0].size();
+
+    }
+
+    std::vector<float> const* VertexAttributes::find_channel (std::string const& name) const {
+
+        for (std::size_t c = 0; c < this->names.size(); c++) {
+
+            if (this->names[c] == name) return &this->channels[c];
+
+        }
+
+        return nullptr;
+
+    }
+
+    VertexAttributes VertexAttributes::gather (std::vector<std::uint32_t> const& order) const {
+
+        VertexAttributes result;
+
+        result.names = this->names;
+        result.channels.resize(this->channels.size());
+
+        for (std::size_t c = 0; c < this->channels.size(); c++) {
+
+            result.channels[c].reserve(order.size());
+            for (auto const& index : order) {
+
+                if (index >= this->channels[c].size()) throw std::out_of_range("Error: Vertex index out of range of the attributes!");
+                result.channels[c].push_back(this->channels[c][index]);
+
+            }
+
+        }
+
+        return result;
+
+    }
+
+    VertexAttributes VertexAttributes::merge (std::vector<std::uint32_t> const& remap, std::size_t merged_count) const {
+
+        if (remap.size() != this->get_vertex_count()) throw std::invalid_argument("Error: Remap size does not match the attributes!");
+
+        VertexAttributes result;
+        std::vector<bool> is_set(merged_count, false);
+
+        result.names = this->names;
+        result.channels.assign(this->channels.size(), std::vector<float>(merged_count, 0.0f));
+
+        for (std::size_t i = 0; i < remap.size(); i++) {
+
+            if (remap[i] >= merged_count) throw std::out_of_range("Error: Remap index out of range!");
+            if (is_set[remap[i]]) continue;
+
+            is_set[remap[i]] = true;
+            for (std::size_t c = 0; c < this->channels.size(); c++) {
+
+                result.channels[c][remap[i]] = this->channels[c][i];
+
+            }
+
+        }
+
+        return result;
+
+    }
+
+    void VertexAttributes::append (VertexAttributes const& other) {
+
+        if (this->channels.empty() && this->names.empty()) {
+
+            *this = other;
+            return;
+
+        }
+        if (other.names != this->names) throw std::invalid_argument("Error: Appended attributes have different channels!");
+
+        for (std::size_t c = 0; c < this->channels.size(); c++) {
+
+            this->channels[c].insert(this->channels[c].end(), other.channels[c].begin(), other.channels[c].end());
+
+        }
+
+    }
+
+}
@@ -0,0 +1,37 @@
+#ifndef TRIANGULATION_VERTEXATTRIBUTES_HPP
+#define TRIANGULATION_VERTEXATTRIBUTES_HPP
+
+#include <vector>
+#include <string>
+#include <cstdint>
+
+namespace triangulation {
+
+    // Per-vertex attribute channels (height, intensity...) in structure-of-arrays form, aligned with a point array: channels[c][i]
+    // is the value of channel c for point i. The engines triangulate the xy points and return indices into them, so the triangles
+    // index the attributes directly; only the steps that reorder or merge points need to carry the attributes along.
+    struct VertexAttributes {
+
+        std::vector<std::string> names;
+        std::vector<std::vector<float>> channels;
+
+        std::size_t get_channel_count () const;
+        std::size_t get_vertex_count () const;
+
+        // Channel with the given name, or nullptr.
+        std::vector<float> const* find_channel (std::string const& name) const;
+
+        // Attributes of the points taken in the given order, as a SpatialSort order or PointDecimator source indices.
+        VertexAttributes gather (std::vector<std::uint32_t> const& order) const;
+
+        // Attributes of the merged points of a PointSnapper remap: each keeps the values of the first point merged into it.
+        VertexAttributes merge (std::vector<std::uint32_t> const& remap, std::size_t merged_count) const;
+
+        // Appends the vertices of attributes with the same channels, as when concatenating groups.
+        void append (VertexAttributes const& other);
+
+    };
+
+}
+
+#endif
@@ -0,0 +1,294 @@
+#include "Voronoi.hpp"
+#include "QuickHull.hpp"
+#include "Parallel.hpp"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <glm/glm.hpp>
+
+namespace triangulation {
+
+    namespace {
+
+        double cross (glm::dvec2 a, glm::dvec2 b) {
+
+            return a.x * b.y - a.y * b.x;
+
+        }
+
+    }
+
+    std::size_t VoronoiDiagram::get_cell_count () const {
+
+        return this->cell_offsets.empty() ? 0 : this->cell_offsets.size() - 1;
+
+    }
+
+    std::vector<glm::dvec2> Voronoi::clip (std::vector<glm::dvec2> const& polygon, std::vector<glm::dvec2> const& clip_polygon) {
+
+        std::vector<glm::dvec2> result = polygon, input;
+
+        for (std::size_t i = 0; i < clip_polygon.size() && !result.empty(); i++) {
+
+            glm::dvec2
+                edge_start = clip_polygon[i],
+                edge = clip_polygon[(i + 1) % clip_polygon.size()] - edge_start;
+
+            input.swap(result);
+            result.clear();
+
+            // Keeping the part of the polygon on the left of the clip edge.
+            for (std::size_t j = 0; j < input.size(); j++) {
+
+                glm::dvec2
+                    current = input[j],
+                    next = input[(j + 1) % input.size()];
+                double
+                    current_side = cross(edge, current - edge_start),
+                    next_side = cross(edge, next - edge_start);
+
+                if (current_side >= 0.0) result.push_back(current);
+                if ((current_side >= 0.0) != (next_side >= 0.0)) result.push_back(current + (next - current) * (current_side / (current_side - next_side)));
+
+            }
+
+        }
+
+        return result;
+
+    }
+
+    VoronoiDiagram Voronoi::compute_diagram (std::vector<glm::vec2> const& points, std::vector<std::uint32_t> const& indices, VoronoiClip clip_mode, unsigned int thread_count) {
+
+        if (indices.size() % 3 != 0) throw std::invalid_argument("Error: Triangle indices count is not a multiple of 3!");
+
+        VoronoiDiagram diagram;
+        std::size_t
+            triangle_count = indices.size() / 3,
+            half_edge_count = indices.size();
+        std::vector<std::uint32_t>
+            corners(indices),
+            half_edge_offsets(points.size() + 1, 0),
+            half_edges_by_origin(half_edge_count),
+            twins(half_edge_count, no_half_edge);
+        std::vector<glm::dvec2> clip_polygon;
+        glm::vec2
+            min_corner(std::numeric_limits<float>::max()),
+            max_corner(-std::numeric_limits<float>::max());
+
+        thread_count = get_thread_count(thread_count);
+
+        for (auto const& point : points) {
+
+            min_corner = glm::min(min_corner, point);
+            max_corner = glm::max(max_corner, point);
+
+        }
+
+        if (clip_mode == CONVEX_HULL) {
+
+            for (auto const& hull_point : QuickHull::compute_hull(points)) {
+
+                clip_polygon.emplace_back(hull_point);
+
+            }
+
+            double area = 0.0;
+            for (std::size_t i = 0; i < clip_polygon.size(); i++) {
+
+                area += cross(clip_polygon[i], clip_polygon[(i + 1) % clip_polygon.size()]);
+
+            }
+            if (area < 0.0) std::reverse(clip_polygon.begin(), clip_polygon.end());
+
+        } else if (!points.empty()) {
+
+            clip_polygon = {glm::dvec2(min_corner), glm::dvec2(max_corner.x, min_corner.y), glm::dvec2(max_corner), glm::dvec2(min_corner.x, max_corner.y)};
+
+        }
+
+        diagram.circumcenters_x.resize(triangle_count);
+        diagram.circumcenters_y.resize(triangle_count);
+
+        // Making every triangle counterclockwise and computing its circumcenter.
+        parallel_for(triangle_count, thread_count, [&] (std::size_t begin, std::size_t end) {
+
+            for (std::size_t t = begin; t < end; t++) {
+
+                glm::dvec2
+                    a(points[corners[3*t]]),
+                    b = glm::dvec2(points[corners[3*t + 1]]) - a,
+                    c = glm::dvec2(points[corners[3*t + 2]]) - a;
+                double d = 2.0 * cross(b, c);
+
+                if (d < 0.0) {
+
+                    std::swap(corners[3*t + 1], corners[3*t + 2]);
+                    std::swap(b, c);
+                    d = -d;
+
+                }
+
+                glm::dvec2 center = (d == 0.0) ? a + (b + c) / 3.0 : a + glm::dvec2(c.y * (b.x*b.x + b.y*b.y) - b.y * (c.x*c.x + c.y*c.y), b.x * (c.x*c.x + c.y*c.y) - c.x * (b.x*b.x + b.y*b.y)) / d;
+                diagram.circumcenters_x[t] = static_cast<float>(center.x);
+                diagram.circumcenters_y[t] = static_cast<float>(center.y);
+
+            }
+
+        });
+
+        // Half-edge h goes from corners[h] to the next corner of its triangle; bucketing them by origin (counting sort) lets each
+        // find its twin among the few half-edges leaving its destination.
+        auto next = [] (std::uint32_t h) { return (h % 3 == 2) ? h - 2 : h + 1; };
+        auto previous = [] (std::uint32_t h) { return (h % 3 == 0) ? h + 2 : h - 1; };
+
+        for (std::size_t h = 0; h < half_edge_count; h++) {
+
+            if (corners[h] >= points.size()) throw std::out_of_range("Error: Triangle index out of range!");
+            half_edge_offsets[corners[h] + 1]++;
+
+        }
+        for (std::size_t v = 0; v < points.size(); v++) {
+
+            half_edge_offsets[v + 1] += half_edge_offsets[v];
+
+        }
+        {
+
+            std::vector<std::uint32_t> positions(half_edge_offsets.begin(), half_edge_offsets.end() - 1);
+            for (std::uint32_t h = 0; h < half_edge_count; h++) {
+
+                half_edges_by_origin[positions[corners[h]]++] = h;
+
+            }
+
+        }
+
+        parallel_for(half_edge_count, thread_count, [&] (std::size_t begin, std::size_t end) {
+
+            for (std::size_t h = begin; h < end; h++) {
+
+                std::uint32_t
+                    origin = corners[h],
+                    destination = corners[next(h)];
+
+                for (std::uint32_t i = half_edge_offsets[destination]; i < half_edge_offsets[destination + 1]; i++) {
+
+                    if (corners[next(half_edges_by_origin[i])] == origin) {
+
+                        twins[h] = half_edges_by_origin[i];
+                        break;
+
+                    }
+
+                }
+
+            }
+
+        });
+
+        // Building the cells, each thread into its own arrays, then concatenating them.
+        glm::dvec2 center = (glm::dvec2(min_corner) + glm::dvec2(max_corner)) / 2.0;
+        double far_distance = 2.0 * glm::length(glm::dvec2(max_corner) - glm::dvec2(min_corner)) + 1.0;
+        std::size_t range_count = std::max<std::size_t>(1, std::min<std::size_t>(thread_count, points.size()));
+        std::vector<std::vector<glm::dvec2>> range_vertices(range_count);
+        std::vector<std::uint32_t> cell_sizes(points.size(), 0);
+
+        parallel_for(range_count, range_count, [&] (std::size_t range_begin, std::size_t range_end) {
+
+            for (std::size_t range = range_begin; range < range_end; range++) {
+
+                std::vector<glm::dvec2> cell;
+
+                for (std::size_t v = range * points.size() / range_count; v < (range + 1) * points.size() / range_count; v++) {
+
+                    if (half_edge_offsets[v] == half_edge_offsets[v + 1]) continue;
+
+                    // Starting from the half-edge leaving v with no twin (the clockwise-most triangle of a hull point), or any for inner points.
+                    std::uint32_t start = half_edges_by_origin[half_edge_offsets[v]];
+                    bool is_on_hull = false;
+
+                    for (std::uint32_t i = half_edge_offsets[v]; i < half_edge_offsets[v + 1]; i++) {
+
+                        if (twins[half_edges_by_origin[i]] == no_half_edge) {
+
+                            start = half_edges_by_origin[i];
+                            is_on_hull = true;
+                            break;
+
+                        }
+
+                    }
+
+                    // Turning counterclockwise around v: the triangle after the one of h shares the edge entering v.
+                    auto circumcenter = [&diagram] (std::uint32_t h) { return glm::dvec2(diagram.circumcenters_x[h / 3], diagram.circumcenters_y[h / 3]); };
+                    std::uint32_t h = start, last = start;
+
+                    cell.clear();
+                    do {
+
+                        cell.push_back(circumcenter(h));
+                        last = h;
+                        h = twins[previous(h)];
+
+                    } while (h != no_half_edge && h != start && cell.size() <= half_edge_count);
+
+                    // The cell of a hull point is unbounded: it is closed far away along the outer normals of its two hull edges.
+                    if (is_on_hull) {
+
+                        glm::dvec2
+                            first_edge = glm::dvec2(points[corners[next(start)]]) - glm::dvec2(points[v]),
+                            last_edge = glm::dvec2(points[v]) - glm::dvec2(points[corners[previous(last)]]),
+                            first_normal = glm::dvec2(first_edge.y, -first_edge.x) / std::max(glm::length(first_edge), 1e-300),
+                            last_normal = glm::dvec2(last_edge.y, -last_edge.x) / std::max(glm::length(last_edge), 1e-300),
+                            first_center = circumcenter(start),
+                            last_center = circumcenter(last);
+
+                        cell.push_back(last_center + last_normal * (glm::length(last_center - center) + far_distance));
+                        cell.push_back(first_center + first_normal * (glm::length(first_center - center) + far_distance));
+
+                    }
+
+                    if (!clip_polygon.empty()) cell = Voronoi::clip(cell, clip_polygon);
+
+                    cell_sizes[v] = static_cast<std::uint32_t>(cell.size());
+                    range_vertices[range].insert(range_vertices[range].end(), cell.begin(), cell.end());
+
+                }
+
+            }
+
+        });
+
+        diagram.cell_offsets.assign(points.size() + 1, 0);
+        for (std::size_t v = 0; v < points.size(); v++) {
+
+            diagram.cell_offsets[v + 1] = diagram.cell_offsets[v] + cell_sizes[v];
+
+        }
+
+        diagram.vertices_x.resize(diagram.cell_offsets.back());
+        diagram.vertices_y.resize(diagram.cell_offsets.back());
+
+        parallel_for(range_count, range_count, [&] (std::size_t range_begin, std::size_t range_end) {
+
+            for (std::size_t range = range_begin; range < range_end; range++) {
+
+                std::size_t offset = diagram.cell_offsets[range * points.size() / range_count];
+
+                for (std::size_t i = 0; i < range_vertices[range].size(); i++) {
+
+                    diagram.vertices_x[offset + i] = static_cast<float>(range_vertices[range][i].x);
+                    diagram.vertices_y[offset + i] = static_cast<float>(range_vertices[range][i].y);
+
+                }
+
+            }
+
+        });
+
+        return diagram;
+
+    }
+
+}
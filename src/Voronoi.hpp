@@ -0,0 +1,55 @@
+#ifndef TRIANGULATION_VORONOI_HPP
+#define TRIANGULATION_VORONOI_HPP
+
+#include <vector>
+#include <cstdint>
+#include <glm/vec2.hpp>
+
+namespace triangulation {
+
+    enum VoronoiClip {
+
+        BOUNDING_BOX,
+        CONVEX_HULL
+
+    };
+
+    // Voronoi diagram in structure-of-arrays form: cell i is the polygon of vertices [cell_offsets[i], cell_offsets[i+1]),
+    // counterclockwise, and is empty for points used by no triangle (duplicates).
+    struct VoronoiDiagram {
+
+        std::vector<float> vertices_x;
+        std::vector<float> vertices_y;
+        std::vector<std::uint32_t> cell_offsets;
+
+        // Circumcenter of each triangle, the Voronoi vertices before clipping.
+        std::vector<float> circumcenters_x;
+        std::vector<float> circumcenters_y;
+
+        std::size_t get_cell_count () const;
+
+    };
+
+    // Extracts the Voronoi diagram dual to a Delaunay triangulation (as computed by SweepHull, or by AdvancingFront for points in
+    // general position) in a linear pass over its triangles. Other triangulations give overlapping cells: run EdgeFlip::make_delaunay
+    // on them first.
+    class Voronoi {
+
+        private:
+
+            static constexpr std::uint32_t no_half_edge = 0xFFFFFFFF;
+
+            // Clips a convex polygon by a convex counterclockwise polygon (Sutherland-Hodgman).
+            static std::vector<glm::dvec2> clip (std::vector<glm::dvec2> const& polygon, std::vector<glm::dvec2> const& clip_polygon);
+
+        public:
+
+            // The cells of hull points are unbounded and every cell is clipped to the bounding box or to the convex hull of the points.
+            // The work is split between thread_count threads (0 uses every hardware thread).
+            static VoronoiDiagram compute_diagram (std::vector<glm::vec2> const& points, std::vector<std::uint32_t> const& indices, VoronoiClip clip_mode = BOUNDING_BOX, unsigned int thread_count = 0);
+
+    };
+
+}
+
+#endif
@@ -1,6 +1,15 @@
 #include <iostream>
 #include <stdexcept>
 #include <random>
+#include <cmath>
+#include <filesystem>
+#include <chrono>
+#include <unistd.h>
+#include <csignal>
+#include <pthread.h>
+#include <exception>
+#include <thread>
+#include <algorithm>
 
 #include <GL/glew.h>
 #define GLFW_INCLUDE_NONE
@@ -12,12 +21,30 @@
 #include "render/Shader.hpp"
 #include "render/Program.hpp"
 #include "render/utils.hpp"
+#include "render/GeometryBuffer.hpp"
+#include "render/GroupBatch.hpp"
+#include "render/UniformBuffer.hpp"
+#include "render/TileQuadtree.hpp"
+#include "render/ThumbnailRenderer.hpp"
+#include "render/FrameProfiler.hpp"
+#include "render/AttributeTexture.hpp"
 #include "scene/Camera.hpp"
 #include "AdvancingFront.hpp"
+#include "SweepHull.hpp"
+#include "QuickHull.hpp"
+#include "SpatialSort.hpp"
+#include "TriangulationJob.hpp"
+#include "TriangulationService.hpp"
+#include "ShardPipeline.hpp"
+#include "ObjFile.hpp"
+#include "PointSnapper.hpp"
+#include "PointGrid.hpp"
+#include "VertexAttributes.hpp"
 
 using namespace triangulation;
 
 const std::string path_to_project = "src";
+const std::string shader_cache_dir = ".shader_cache";
 
 scene::Camera camera(
     glm::vec3(0.0f, 0.0f, 1.0f), // position
@@ -30,9 +57,31 @@ scene::Camera camera(
     0.0f, 500.0f, 0.0f, 500.0f
 );
 
+TriangulationJob job;
+render::GroupBatch groups_batch;
+
+// Group shown alone when cycling through groups with the V key, or -1 when all groups are shown.
+long solo_group = -1;
+
 render::Program program;
-render::Shader vertex_shader(GL_VERTEX_SHADER);
-render::Shader fragment_shader(GL_FRAGMENT_SHADER);
+render::UniformBuffer camera_buffer;
+
+// Heights ("z" channel of the input) of the whole-set points, and whether the points and triangulation are coloured by them (H key).
+render::AttributeTexture height_texture;
+bool render_heights = false;
+
+// Tiles of the whole-set triangulation, built once it is finished.
+render::TileQuadtree triangulation_tiles;
+
+// Set when pan or zoom changed the camera frame.
+bool camera_changed = false;
+
+// CPU and GPU time of the upload, draw and swap phases of each frame.
+render::FrameProfiler frame_profiler;
+enum FramePhase { UPLOAD_PHASE, DRAW_PHASE, SWAP_PHASE };
+
+// File the frame times are exported to on exit ("--profile=<file.csv>"), which also logs the statistics periodically.
+std::string profile_output;
 
 glm::mat4
     model_mat(1.0f), // Model transformation
@@ -43,12 +92,248 @@ bool
     render_groups_triangulations = false,
     render_triangulation = false;
 
-void setup_vertex_array(GLuint vao, GLuint vbo, GLuint attrib_location);
+// Space-filling curve used to presort the points before triangulating ("--presort=hilbert|morton|brio").
+std::string presort_mode;
+
+// Bits per coordinate used to quantize the points before triangulating ("--quantize=<bits>"), 0 disables it.
+unsigned int quantization_bits = 0;
+
+// Points closer than this are merged before triangulating ("--snap=<tolerance>"); duplicates are always merged.
+float snap_tolerance = 0.0f;
+
+// While the whole set is being triangulated, the viewer shows a preview triangulation of the points decimated to a grid of
+// "--preview=<cells>" cells along the longer side (0 disables it), computed within "--preview-budget=<ms>".
+std::size_t preview_resolution = 32;
+unsigned long preview_budget = 250;
+
+// Engine triangulating the points in headless mode ("--engine=advancing-front|sweep-hull"); quantization only applies to advancing-front.
+std::string engine = "advancing-front";
+
+// Benchmark mode times both engines on this many random points and checks each result is Delaunay ("--benchmark" or "--benchmark=<count>").
+std::size_t benchmark_point_count = 0;
+
+// Directory where headless mode writes one image per input file ("--headless=<dir>"); empty opens the viewer.
+std::string headless_output_dir;
+// Width and height of the headless images ("--thumbnail-size=<pixels>").
+std::size_t thumbnail_size = 512;
+
+// Service mode answers triangulation requests from stdin ("--serve") or a Unix domain socket ("--serve=<path>") instead of opening the viewer.
+bool serve = false;
+std::string serve_socket_path;
+// Whether the whole-set triangulation is stitched from the group triangulations, or computed again from scratch ("--no-stitch").
+bool stitch_groups = true;
+
+// Worker threads of the service ("--workers=<count>"), 0 uses every hardware thread.
+unsigned int service_workers = 0;
+// Time budget of each service request in milliseconds ("--time-budget=<ms>"), 0 for no limit.
+unsigned long service_time_budget = 0;
+// Largest number of points of a service request ("--max-points=<count>"); larger requests are answered with an error.
+std::size_t service_max_points = 1 << 24;
+
+// Sharded pipeline: "--sharded=<dir>" partitions, triangulates the shards in worker processes and merges them,
+// "--partition=<dir>" and "--merge=<dir>" run the first and last steps alone, "--triangulate-shard=<file>" is the worker.
+std::string sharded_dir, partition_dir, merge_dir, shard_file;
+// Shard grid side ("--shards=<n>" gives n x n shards), worker processes ("--processes=<count>") and overlap ("--margin=<fraction>").
+std::size_t shard_grid_size = 2;
+std::size_t shard_processes = 0;
+float shard_margin = 0.25f;
+
+std::vector<std::uint32_t> presort_order(std::vector<glm::vec2> const& points);
+std::vector<glm::vec2> presort_points(std::vector<glm::vec2> const& points);
+int render_headless(std::vector<std::string> const& input_files);
+int run_sharded(std::vector<std::string> const& input_files);
+int run_benchmark();
 
 int main(int argc, char * argv[]) {
 
     try {
 
+        // Parsing command line: options start with "--", the other arguments are input files.
+        // The viewer shows the first input file, headless mode renders all of them.
+        std::vector<std::string> input_files;
+        for (int i = 1; i < argc; ++i) {
+
+            std::string argument(argv[i]);
+
+            if (argument.rfind("--presort=", 0) == 0) {
+
+                presort_mode = argument.substr(std::string("--presort=").size());
+                if (presort_mode != "hilbert" && presort_mode != "morton" && presort_mode != "brio") throw std::invalid_argument("Unknown presort mode: " + presort_mode);
+
+            } else if (argument.rfind("--quantize=", 0) == 0) {
+
+                quantization_bits = std::stoul(argument.substr(std::string("--quantize=").size()));
+
+            } else if (argument.rfind("--headless=", 0) == 0) {
+
+                headless_output_dir = argument.substr(std::string("--headless=").size());
+
+            } else if (argument == "--no-stitch") {
+
+                stitch_groups = false;
+
+            } else if (argument == "--serve") {
+
+                serve = true;
+
+            } else if (argument.rfind("--serve=", 0) == 0) {
+
+                serve = true;
+                serve_socket_path = argument.substr(std::string("--serve=").size());
+
+            } else if (argument.rfind("--workers=", 0) == 0) {
+
+                service_workers = std::stoul(argument.substr(std::string("--workers=").size()));
+
+            } else if (argument.rfind("--time-budget=", 0) == 0) {
+
+                service_time_budget = std::stoul(argument.substr(std::string("--time-budget=").size()));
+
+            } else if (argument.rfind("--max-points=", 0) == 0) {
+
+                service_max_points = std::stoul(argument.substr(std::string("--max-points=").size()));
+
+            } else if (argument.rfind("--sharded=", 0) == 0) {
+
+                sharded_dir = argument.substr(std::string("--sharded=").size());
+
+            } else if (argument.rfind("--partition=", 0) == 0) {
+
+                partition_dir = argument.substr(std::string("--partition=").size());
+
+            } else if (argument.rfind("--merge=", 0) == 0) {
+
+                merge_dir = argument.substr(std::string("--merge=").size());
+
+            } else if (argument.rfind("--triangulate-shard=", 0) == 0) {
+
+                shard_file = argument.substr(std::string("--triangulate-shard=").size());
+
+            } else if (argument.rfind("--shards=", 0) == 0) {
+
+                shard_grid_size = std::stoul(argument.substr(std::string("--shards=").size()));
+
+            } else if (argument.rfind("--processes=", 0) == 0) {
+
+                shard_processes = std::stoul(argument.substr(std::string("--processes=").size()));
+
+            } else if (argument.rfind("--margin=", 0) == 0) {
+
+                shard_margin = std::stof(argument.substr(std::string("--margin=").size()));
+
+            } else if (argument.rfind("--preview=", 0) == 0) {
+
+                preview_resolution = std::stoul(argument.substr(std::string("--preview=").size()));
+
+            } else if (argument.rfind("--preview-budget=", 0) == 0) {
+
+                preview_budget = std::stoul(argument.substr(std::string("--preview-budget=").size()));
+
+            } else if (argument.rfind("--snap=", 0) == 0) {
+
+                snap_tolerance = std::stof(argument.substr(std::string("--snap=").size()));
+
+            } else if (argument.rfind("--engine=", 0) == 0) {
+
+                engine = argument.substr(std::string("--engine=").size());
+                if (engine != "advancing-front" && engine != "sweep-hull") throw std::invalid_argument("Error: Unknown engine " + engine + "!");
+
+            } else if (argument == "--benchmark") {
+
+                benchmark_point_count = 1000;
+
+            } else if (argument.rfind("--benchmark=", 0) == 0) {
+
+                benchmark_point_count = std::stoul(argument.substr(std::string("--benchmark=").size()));
+
+            } else if (argument.rfind("--profile=", 0) == 0) {
+
+                profile_output = argument.substr(std::string("--profile=").size());
+
+            } else if (argument.rfind("--thumbnail-size=", 0) == 0) {
+
+                thumbnail_size = std::stoul(argument.substr(std::string("--thumbnail-size=").size()));
+
+            } else {
+
+                input_files.push_back(argument);
+
+            }
+
+        }
+
+        if (benchmark_point_count > 0) {
+
+            return run_benchmark();
+
+        }
+
+        if (!shard_file.empty()) {
+
+            ShardPipeline::triangulate_shard(shard_file);
+            return EXIT_SUCCESS;
+
+        }
+
+        if (!sharded_dir.empty() || !partition_dir.empty() || !merge_dir.empty()) {
+
+            return run_sharded(input_files);
+
+        }
+
+        if (serve) {
+
+            // SIGINT and SIGTERM are blocked in every thread and waited for by one that stops the service, since stop() takes
+            // locks and cannot run in a signal handler. The mask is set before the service starts its threads, which inherit it.
+            sigset_t stop_signals;
+            sigemptyset(&stop_signals);
+            sigaddset(&stop_signals, SIGINT);
+            sigaddset(&stop_signals, SIGTERM);
+            pthread_sigmask(SIG_BLOCK, &stop_signals, nullptr);
+
+            TriangulationService service(service_workers, 64, std::chrono::milliseconds(service_time_budget), service_max_points);
+            std::exception_ptr error;
+            std::thread signal_waiter([&service, &stop_signals] () {
+
+                int signal;
+                sigwait(&stop_signals, &signal);
+                service.stop();
+
+            });
+
+            try {
+
+                if (serve_socket_path.empty()) {
+
+                    service.serve_stream(STDIN_FILENO, STDOUT_FILENO);
+
+                } else {
+
+                    service.serve_socket(serve_socket_path);
+
+                }
+
+            } catch (...) {
+
+                error = std::current_exception();
+
+            }
+
+            // Releasing the signal waiter when serving ended on its own.
+            pthread_kill(signal_waiter.native_handle(), SIGTERM);
+            signal_waiter.join();
+
+            if (error) std::rethrow_exception(error);
+            return EXIT_SUCCESS;
+
+        }
+
+        if (!headless_output_dir.empty()) {
+
+            return render_headless(input_files);
+
+        }
+
         // Setting GLFW error callback function.
         glfwSetErrorCallback(render::glfw_error_callback);
 
@@ -64,6 +349,7 @@ int main(int argc, char * argv[]) {
         // Setting GLFW callbacks.
         glfwSetKeyCallback(window.get_glfw_handle(), render::glfw_key_callback);
         glfwSetFramebufferSizeCallback(window.get_glfw_handle(), render::glfw_framebuffer_size_callback);
+        glfwSetScrollCallback(window.get_glfw_handle(), render::glfw_scroll_callback);
 
         window.activate_context();
         glfwSwapInterval(1);
@@ -85,27 +371,40 @@ int main(int argc, char * argv[]) {
 
         render::enable_openGL_debug_messages(false);
 
-        program.create();
+        // Reusing the program binary cached by a previous run when the shaders and the driver did not change.
+        program.build({
+            {GL_VERTEX_SHADER, path_to_project + "/shaders/main.vert"},
+            {GL_FRAGMENT_SHADER, path_to_project + "/shaders/main.frag"}
+        }, shader_cache_dir);
+        program.use();
 
-        vertex_shader.compile(path_to_project + "/shaders/main.vert");
-        program.attach(vertex_shader);
+        // Uniform locations are looked up once, the setters skip values that did not change.
+        render::Program::UniformHandle
+            frag_color_uniform = program.get_uniform("frag_color"),
+            use_group_colors_uniform = program.get_uniform("use_group_colors"),
+            use_height_colors_uniform = program.get_uniform("use_height_colors");
 
-        fragment_shader.compile(path_to_project + "/shaders/main.frag");
-        program.attach(fragment_shader);
+        program.set_uniform(program.get_uniform("model_mat"), model_mat);
+        program.set_uniform(program.get_uniform("group_colors"), 0);
+        program.set_uniform(use_group_colors_uniform, GL_FALSE);
+        program.set_uniform(program.get_uniform("heights"), 1);
+        program.set_uniform(use_height_colors_uniform, GL_FALSE);
 
-        program.link();
-        program.use();
-
-        glUniformMatrix4fv(glGetUniformLocation(program.get_id(), "model_mat"), 1, GL_FALSE, glm::value_ptr(model_mat));
-        glUniformMatrix4fv(glGetUniformLocation(program.get_id(), "view_mat"), 1, GL_FALSE, glm::value_ptr(view_mat));
-        glUniformMatrix4fv(glGetUniformLocation(program.get_id(), "projection_mat"), 1, GL_FALSE, glm::value_ptr(projection_mat));
+        // Camera matrices (std140 block "Camera": view_mat at offset 0, projection_mat at offset 64).
+        camera_buffer.create(2*sizeof(glm::mat4), 0);
+        program.bind_uniform_block("Camera", 0);
+        camera_buffer.update(0, sizeof(glm::mat4), glm::value_ptr(view_mat));
+        camera_buffer.update(sizeof(glm::mat4), sizeof(glm::mat4), glm::value_ptr(projection_mat));
 
         GLuint pos_attrib = glGetAttribLocation(program.get_id(), "pos");
+        GLuint group_attrib = glGetAttribLocation(program.get_id(), "group");
 
+        // The attributes of each group stay aligned with its points through presorting and merging.
         std::vector<std::vector<glm::vec2>> vertices_groups;
-        if (argc > 1) {
+        std::vector<VertexAttributes> groups_attributes;
+        if (!input_files.empty()) {
 
-            vertices_groups = render::parse_obj(argv[1]);
+            vertices_groups = ObjFile::read(input_files[0], groups_attributes);
 
         } else {
 
@@ -115,6 +414,7 @@ int main(int argc, char * argv[]) {
             std::uniform_real_distribution<float> dist(camera.get_left() + (camera.get_right() - camera.get_left())/20.0f, camera.get_right() - (camera.get_right() - camera.get_left())/20.0f);
 
             vertices_groups.push_back(std::vector<glm::vec2>());
+            groups_attributes.push_back(VertexAttributes());
 
             for (int i = 0; i < 50; ++i) {
 
@@ -126,7 +426,22 @@ int main(int argc, char * argv[]) {
 
         }
 
+        // The whole set is the concatenation of the (presorted) groups, so its triangulation can be stitched from theirs.
+        if (!presort_mode.empty()) {
+
+            for (std::size_t i = 0; i < vertices_groups.size(); i++) {
+
+                std::vector<std::uint32_t> order = presort_order(vertices_groups[i]);
+
+                vertices_groups[i] = SpatialSort::apply_order(vertices_groups[i], order);
+                groups_attributes[i] = groups_attributes[i].gather(order);
+
+            }
+
+        }
+
         std::vector<glm::vec2> vertices;
+        VertexAttributes attributes;
         for (std::size_t i = 0; i < vertices_groups.size(); i++) {
 
             for (std::size_t j = 0; j < vertices_groups[i].size(); j++) {
@@ -134,71 +449,255 @@ int main(int argc, char * argv[]) {
                 vertices.push_back(vertices_groups[i][j]);
 
             }
+            attributes.append(groups_attributes[i]);
 
         }
 
-        std::vector<glm::vec2> triangulation = AdvancingFront::compute_triangulation(vertices);
+        // Merging the points shared by several groups (and the points closer than the snapping tolerance) before any engine runs.
+        // The groups keep their points, moved to the merged positions, and the remap table takes stitched indices to the merged points.
+        PointSnapper::Result snapped = PointSnapper::snap(vertices, snap_tolerance);
+        std::size_t snapped_index = 0;
+        for (auto& group : vertices_groups) {
 
-        std::vector<std::vector<glm::vec2>> groups_triangulation;
-        for (std::size_t i = 0; i < vertices_groups.size(); i++) {
+            for (auto& point : group) {
 
-            groups_triangulation.push_back(AdvancingFront::compute_triangulation(vertices_groups[i]));
+                point = snapped.points[snapped.remap[snapped_index++]];
+
+            }
 
         }
+        if (snapped.points.size() < vertices.size()) std::cout << "Merged " << vertices.size() - snapped.points.size() << " duplicated points." << std::endl;
+        attributes = attributes.merge(snapped.remap, snapped.points.size());
+        vertices = std::move(snapped.points);
 
-        std::vector<GLuint> vao(2 + groups_triangulation.size(), 0);
-        std::vector<GLuint> vbo_pos(2 + groups_triangulation.size(), 0);
+        // The triangulations index the merged points, so the shaders fetch the height of each vertex by its index.
+        if (std::vector<float> const* heights = attributes.find_channel("z")) {
 
-        for (std::size_t i = 0; i < 2 + groups_triangulation.size(); i++) {
-        
-            glGenVertexArrays(1, &vao[i]);
-            glGenBuffers(1, &vbo_pos[i]);
-            setup_vertex_array(vao[i], vbo_pos[i], pos_attrib);
+            auto [min_height, max_height] = std::minmax_element(heights->begin(), heights->end());
+
+            if (min_height != heights->end() && *min_height < *max_height) {
+
+                height_texture.create(*heights);
+                program.set_uniform(program.get_uniform("height_range"), glm::vec2(*min_height, *max_height));
+                render_heights = true;
+                std::cout << "Heights from " << *min_height << " to " << *max_height << " (H toggles height colours)." << std::endl;
+
+            }
 
         }
 
+        // Triangulating each group (tasks 1..n) and the whole set (task 0) on a worker thread, while the window loop runs.
+        std::vector<std::vector<glm::vec2>> point_sets;
+        point_sets.push_back(vertices);
+        point_sets.insert(point_sets.end(), vertices_groups.begin(), vertices_groups.end());
+
+        // The hull of the whole set is merged from the group hulls instead of being computed again over every point.
+        std::vector<std::vector<glm::vec2>> hulls(1);
+        for (auto const& group : vertices_groups) {
+
+            hulls.push_back(QuickHull::compute_hull(group));
+
+        }
+        hulls[0] = QuickHull::merge_hulls(std::vector<std::vector<glm::vec2>>(hulls.begin() + 1, hulls.end()));
+
+        // The job's worker first triangulates a decimated preview of the whole set, which the window loop picks up when it is done.
+        job.set_preview(preview_resolution, std::chrono::milliseconds(preview_budget));
+        job.start(std::move(point_sets), quantization_bits, std::move(hulls), stitch_groups, snapped.remap);
+
+        if (quantization_bits > 0) {
+
+            std::cout << "Quantized " << vertices.size() << " points to " << quantization_bits << " bits per coordinate (max error " << job.get_quantization_error(0) << ")." << std::endl;
+
+        }
+
+        std::vector<std::uint32_t> triangulation;
+        std::vector<std::vector<std::uint32_t>> groups_triangulation(vertices_groups.size());
+        std::vector<glm::vec2> frontier, visible_frontier;
+        std::vector<std::vector<glm::vec2>> groups_frontier(vertices_groups.size());
+        bool job_was_running = true;
+
+        // The points are uploaded once; the triangulations are index buffers over them, appended as the job produces triangles.
+        // All groups share the buffers of one batch and are drawn with a single call.
+        render::GeometryBuffer points_buffer;
+        render::GeometryBuffer frontier_buffer(GL_STREAM_DRAW);
+
+        points_buffer.create(pos_attrib);
+        points_buffer.sync_vertices(vertices);
+        groups_batch.create(vertices_groups, pos_attrib, group_attrib);
+        frontier_buffer.create(pos_attrib);
+
+        render::GeometryBuffer preview_buffer;
+        std::vector<glm::vec2> preview_points;
+        AdvancingFront::Result preview;
+
+        // The rolling frame statistics are shown in the window title every second, and logged every five seconds when profiling.
+        frame_profiler.create({"upload", "draw", "swap"});
+        std::string window_title = window.get_title();
+        auto last_title_update = std::chrono::steady_clock::now();
+        auto last_log = last_title_update;
+
         // Window loop
         while (!glfwWindowShouldClose(window.get_glfw_handle())) {
 
+            frame_profiler.begin_frame();
+            frame_profiler.begin_phase(UPLOAD_PHASE);
+
+            // Streaming the partial results of the job.
+            if (job.fetch_preview(preview_points, preview)) {
+
+                preview_buffer.create(pos_attrib);
+                preview_buffer.sync_vertices(preview_points);
+                preview_buffer.sync_indices(preview.indices);
+                std::cout << "Preview of " << preview_points.size() << " points: " << preview.indices.size()/3 << " triangles" << (preview.is_partial ? " (time budget exceeded)." : ".") << std::endl;
+
+            }
+
+            bool triangulation_finished = job.is_finished(0);
+            if (job.fetch(0, triangulation, frontier)) points_buffer.sync_indices(triangulation);
+
+            // Once the whole-set triangulation is complete, it is drawn through culled tiles.
+            if (triangulation_finished && !triangulation_tiles.is_created()) {
+
+                triangulation_tiles.create(vertices, triangulation, points_buffer.get_vbo(), pos_attrib);
+
+            }
+
+            if (camera_changed) {
+
+                projection_mat = camera.get_projection_matrix();
+                camera_buffer.update(sizeof(glm::mat4), sizeof(glm::mat4), glm::value_ptr(projection_mat));
+                camera_changed = false;
+
+            }
+            for (std::size_t i = 0; i < groups_triangulation.size(); i++) {
+
+                if (job.fetch(i + 1, groups_triangulation[i], groups_frontier[i])) groups_batch.sync_indices(i, groups_triangulation[i]);
+
+            }
+
+            if (job_was_running && !job.is_running()) {
+
+                std::cout << (job.is_cancelled() ? "Triangulation cancelled, showing partial results." : "Triangulation finished.") << std::endl;
+                job_was_running = false;
+
+            }
+
+            frame_profiler.begin_phase(DRAW_PHASE);
+
             // glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
             glClear(GL_COLOR_BUFFER_BIT);
             glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
 
-            glUniform4f(glGetUniformLocation(program.get_id(), "frag_color"), 1.0f, 1.0f, 1.0f, 1.0f);
+            program.set_uniform(frag_color_uniform, glm::vec4(1.0f, 1.0f, 1.0f, 1.0f));
+
+            // Height colours only apply to the draws indexing the whole-set points.
+            if (render_heights) {
+
+                height_texture.bind(1);
+                program.set_uniform(use_height_colors_uniform, GL_TRUE);
+
+            }
 
-            glBindVertexArray(vao[0]);
-            glBindBuffer(GL_ARRAY_BUFFER, vbo_pos[0]);
-            glBufferData(GL_ARRAY_BUFFER, sizeof(glm::vec2)*vertices.size(), vertices.data(), GL_STATIC_DRAW);
             glPointSize(5);
-            glDrawArrays(GL_POINTS, 0, vertices.size());
+            points_buffer.draw_arrays(GL_POINTS);
+
+            visible_frontier.clear();
 
             if (render_triangulation) {
 
-                glBindVertexArray(vao[1]);
-                glBindBuffer(GL_ARRAY_BUFFER, vbo_pos[1]);
-                glBufferData(GL_ARRAY_BUFFER, sizeof(glm::vec2)*triangulation.size(), triangulation.data(), GL_STATIC_DRAW);
-                glDrawArrays(GL_TRIANGLES, 0, triangulation.size());
+                if (triangulation_tiles.is_created()) {
+
+                    int framebuffer_width, framebuffer_height;
+                    glfwGetFramebufferSize(window.get_glfw_handle(), &framebuffer_width, &framebuffer_height);
+                    triangulation_tiles.draw(projection_mat * view_mat, glm::vec2(framebuffer_width, framebuffer_height));
+
+                } else {
+
+                    if (preview_buffer.get_index_count() > 0) {
+
+                        program.set_uniform(use_height_colors_uniform, GL_FALSE);
+                        program.set_uniform(frag_color_uniform, glm::vec4(0.4f, 0.4f, 0.4f, 1.0f));
+                        preview_buffer.draw_elements(GL_TRIANGLES);
+                        program.set_uniform(frag_color_uniform, glm::vec4(1.0f, 1.0f, 1.0f, 1.0f));
+                        program.set_uniform(use_height_colors_uniform, render_heights ? GL_TRUE : GL_FALSE);
+
+                    }
+                    points_buffer.draw_elements(GL_TRIANGLES);
+
+                }
+                visible_frontier.insert(visible_frontier.end(), frontier.begin(), frontier.end());
 
             }
 
+            program.set_uniform(use_height_colors_uniform, GL_FALSE);
+
             if (render_groups_triangulations) {
 
-                for (std::size_t i = 0; i < groups_triangulation.size(); i++) {
+                program.set_uniform(use_group_colors_uniform, GL_TRUE);
+                groups_batch.bind_colors(0);
+                groups_batch.draw(GL_TRIANGLES);
+                program.set_uniform(use_group_colors_uniform, GL_FALSE);
+
+                for (std::size_t i = 0; i < groups_frontier.size(); i++) {
 
-                    glBindVertexArray(vao[i + 2]);
-                    glBindBuffer(GL_ARRAY_BUFFER, vbo_pos[i + 2]);
-                    glBufferData(GL_ARRAY_BUFFER, sizeof(glm::vec2)*groups_triangulation[i].size(), groups_triangulation[i].data(), GL_STATIC_DRAW);
-                    glDrawArrays(GL_TRIANGLES, 0, groups_triangulation[i].size());
+                    if (groups_batch.is_visible(i)) visible_frontier.insert(visible_frontier.end(), groups_frontier[i].begin(), groups_frontier[i].end());
 
                 }
 
             }
 
+            // Drawing the frontier of the triangulations still in progress, which changes completely between snapshots.
+            if (!visible_frontier.empty()) {
+
+                program.set_uniform(frag_color_uniform, glm::vec4(1.0f, 0.0f, 0.0f, 1.0f));
+                frontier_buffer.stream_vertices(visible_frontier);
+                frontier_buffer.draw_arrays(GL_LINES);
+
+            }
+
+            frame_profiler.begin_phase(SWAP_PHASE);
+
             glfwSwapBuffers(window.get_glfw_handle());
             glfwPollEvents();
 
+            frame_profiler.end_frame();
+
+            auto now = std::chrono::steady_clock::now();
+            if (now - last_title_update >= std::chrono::seconds(1)) {
+
+                window.set_title(window_title + " - " + frame_profiler.get_summary());
+                last_title_update = now;
+
+            }
+            if (!profile_output.empty() && now - last_log >= std::chrono::seconds(5)) {
+
+                std::cout << "Frame " << frame_profiler.get_frame_count() << ": " << frame_profiler.get_summary() << std::endl;
+                last_log = now;
+
+            }
+
+        }
+
+        if (!profile_output.empty()) {
+
+            frame_profiler.write_csv(profile_output);
+            std::cout << "Frame times written to " << profile_output << std::endl;
+
         }
 
+        job.cancel();
+        job.wait();
+
+        // Releasing GPU resources while the context still exists.
+        points_buffer.destroy();
+        preview_buffer.destroy();
+        triangulation_tiles.destroy();
+        groups_batch.destroy();
+        frontier_buffer.destroy();
+        height_texture.destroy();
+        camera_buffer.destroy();
+        frame_profiler.destroy();
+
         glfwDestroyWindow(window.get_glfw_handle());
         glfwTerminate();
 
@@ -213,12 +712,222 @@ int main(int argc, char * argv[]) {
 
 }
 
-void setup_vertex_array(GLuint vao, GLuint vbo, GLuint attrib_location) {
+std::vector<std::uint32_t> presort_order(std::vector<glm::vec2> const& points) {
+
+    if (presort_mode == "brio") return SpatialSort::compute_brio_order(points);
+    return SpatialSort::compute_order(points, (presort_mode == "morton") ? MORTON : HILBERT);
+
+}
+
+std::vector<glm::vec2> presort_points(std::vector<glm::vec2> const& points) {
+
+    return SpatialSort::apply_order(points, presort_order(points));
+
+}
+
+int render_headless(std::vector<std::string> const& input_files) {
+
+    render::ThumbnailRenderer renderer;
+
+    renderer.create(thumbnail_size, thumbnail_size, path_to_project + "/shaders", shader_cache_dir);
+    std::filesystem::create_directories(headless_output_dir);
+
+    for (auto const& input_file : input_files) {
+
+        std::vector<glm::vec2> vertices;
+        std::vector<std::uint32_t> triangulation;
+
+        // Without snapping or presorting the points go straight from the file to quantized storage, and the glm::vec2 copy
+        // the renderer needs is only made once they are triangulated.
+        if (quantization_bits > 0 && engine != "sweep-hull" && snap_tolerance <= 0.0f && presort_mode.empty()) {
+
+            CompactPoints points = ObjFile::read_compact(input_file, quantization_bits);
+
+            triangulation = AdvancingFront::compute_triangulation_indices(points);
+            vertices = points.dequantize();
+
+        } else {
+
+            for (auto const& group : ObjFile::read(input_file)) {
+
+                vertices.insert(vertices.end(), group.begin(), group.end());
+
+            }
+            vertices = PointSnapper::snap(vertices, snap_tolerance).points;
+            if (!presort_mode.empty()) vertices = presort_points(vertices);
+
+            if (engine == "sweep-hull") {
+
+                triangulation = SweepHull::compute_triangulation_indices(vertices);
+
+            } else if (quantization_bits > 0) {
+
+                triangulation = AdvancingFront::compute_triangulation_indices(CompactPoints(vertices, quantization_bits));
+
+            } else {
+
+                triangulation = AdvancingFront::compute_triangulation_indices(vertices);
+
+            }
+
+        }
+
+        std::string output_file = (std::filesystem::path(headless_output_dir) / std::filesystem::path(input_file).stem()).string() + ".png";
+        renderer.render(vertices, triangulation, output_file);
+        std::cout << input_file << " -> " << output_file << " (" << triangulation.size()/3 << " triangles)" << std::endl;
+
+    }
+
+    renderer.flush();
+
+    return EXIT_SUCCESS;
+
+}
+
+int run_sharded(std::vector<std::string> const& input_files) {
+
+    // The shards only carry xy: the merged triangles index the points file, which the attributes of the merged points line up with.
+    auto load_points = [&input_files] (VertexAttributes& attributes) {
+
+        std::vector<glm::vec2> points;
+        std::vector<VertexAttributes> groups_attributes;
+
+        if (input_files.empty()) throw std::invalid_argument("Error: The sharded pipeline needs an input file!");
+
+        std::vector<std::vector<glm::vec2>> groups = ObjFile::read(input_files[0], groups_attributes);
+        attributes = VertexAttributes();
+        for (std::size_t i = 0; i < groups.size(); i++) {
+
+            points.insert(points.end(), groups[i].begin(), groups[i].end());
+            attributes.append(groups_attributes[i]);
+
+        }
+
+        PointSnapper::Result snapped = PointSnapper::snap(points, snap_tolerance);
+        attributes = attributes.merge(snapped.remap, snapped.points.size());
+
+        return snapped.points;
+
+    };
+
+    auto write_mesh = [] (std::string const& directory, ShardPipeline::MergeResult const& result, VertexAttributes const& attributes) {
+
+        std::string path = (std::filesystem::path(directory) / "merged.obj").string();
+        ObjFile::write(path, ShardPipeline::read_points((std::filesystem::path(directory) / "points.bin").string()), result.indices, attributes);
+        std::cout << path << ": " << result.indices.size()/3 << " triangles, " << result.gap_edges << " gap edges, " << result.conflicting_edges << " conflicting edges" << std::endl;
+
+    };
+
+    VertexAttributes attributes;
+
+    if (!partition_dir.empty()) {
+
+        std::size_t shard_count = ShardPipeline::partition(load_points(attributes), partition_dir, shard_grid_size, shard_grid_size, shard_margin).size();
+        std::cout << "Wrote " << shard_count << " shards to " << partition_dir << std::endl;
+        return EXIT_SUCCESS;
+
+    }
+
+    // Merging alone keeps the attributes when the input file is given again.
+    if (!merge_dir.empty()) {
+
+        if (!input_files.empty()) load_points(attributes);
+        write_mesh(merge_dir, ShardPipeline::merge(merge_dir, ShardPipeline::find_shards(merge_dir)), attributes);
+        return EXIT_SUCCESS;
+
+    }
+
+    // Running every step locally, each shard in its own process; a margin too small to hold the shard
+    // boundary triangles leaves gaps, so the shards are redone with a doubled margin.
+    std::vector<glm::vec2> points = load_points(attributes);
+    std::size_t process_count = (shard_processes > 0) ? shard_processes : std::max(1u, std::thread::hardware_concurrency());
+    ShardPipeline::MergeResult result;
+    float margin = shard_margin;
+
+    for (int attempt = 0; attempt < 4; attempt++) {
+
+        std::vector<std::string> shard_paths = ShardPipeline::partition(points, sharded_dir, shard_grid_size, shard_grid_size, margin);
+
+        ShardPipeline::run_workers("/proc/self/exe", shard_paths, process_count);
+        result = ShardPipeline::merge(sharded_dir, shard_paths);
+
+        if (result.gap_edges == 0 && result.conflicting_edges == 0) break;
+
+        std::cout << "Margin " << margin << " left " << result.gap_edges << " gap edges and " << result.conflicting_edges << " conflicting edges, retrying." << std::endl;
+        margin *= 2.0f;
+
+    }
+
+    write_mesh(sharded_dir, result, attributes);
+
+    return (result.gap_edges == 0 && result.conflicting_edges == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+
+}
+
+int run_benchmark() {
+
+    std::mt19937 generator(0);
+    std::uniform_real_distribution<float> distribution(0.0f, 500.0f);
+    std::vector<glm::vec2> points(benchmark_point_count);
+
+    for (auto& point : points) {
 
-    glBindVertexArray(vao);
-    glEnableVertexAttribArray(attrib_location);
-    glBindBuffer(GL_ARRAY_BUFFER, vbo);
-    glVertexAttribPointer(attrib_location, 2, GL_FLOAT, GL_FALSE, 0, (GLvoid*)0);
+        point = glm::vec2(distribution(generator), distribution(generator));
+
+    }
+
+    // Each engine is checked on its own: every circumcircle must be empty and the triangles must cover the convex hull.
+    PointGrid grid(points);
+    std::vector<glm::vec2> hull = QuickHull::compute_hull(points);
+    double hull_area = 0.0;
+
+    for (std::size_t i = 0; i < hull.size(); ++i) {
+
+        glm::dvec2 a(hull[i]), b(hull[(i + 1) % hull.size()]);
+        hull_area += a.x * b.y - a.y * b.x;
+
+    }
+    hull_area = std::abs(hull_area) / 2.0;
+
+    auto is_delaunay = [&points, &grid, hull_area] (std::vector<std::uint32_t> const& indices) {
+
+        double area = 0.0;
+
+        for (std::size_t i = 0; i + 2 < indices.size(); i += 3) {
+
+            glm::vec2 vertices[3] = {points[indices[i]], points[indices[i + 1]], points[indices[i + 2]]};
+            if (!grid.is_delaunay(vertices)) return false;
+
+            glm::dvec2 edge1 = glm::dvec2(vertices[1]) - glm::dvec2(vertices[0]), edge2 = glm::dvec2(vertices[2]) - glm::dvec2(vertices[0]);
+            area += std::abs(edge1.x * edge2.y - edge1.y * edge2.x) / 2.0;
+
+        }
+
+        return std::abs(area - hull_area) <= 1e-6 * hull_area;
+
+    };
+
+    auto time = [] (auto&& triangulate, std::vector<std::uint32_t>& indices) {
+
+        auto start = std::chrono::steady_clock::now();
+        indices = triangulate();
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    };
+
+    std::vector<std::uint32_t> advancing_front_indices, sweep_hull_indices;
+    double
+        advancing_front_time = time([&points] () { return AdvancingFront::compute_triangulation_indices(points); }, advancing_front_indices),
+        sweep_hull_time = time([&points] () { return SweepHull::compute_triangulation_indices(points); }, sweep_hull_indices);
+    bool
+        advancing_front_valid = is_delaunay(advancing_front_indices),
+        sweep_hull_valid = is_delaunay(sweep_hull_indices);
+
+    std::cout << benchmark_point_count << " random points" << std::endl;
+    std::cout << "advancing-front: " << advancing_front_indices.size()/3 << " triangles in " << advancing_front_time << " ms" << (advancing_front_valid ? "" : ", not Delaunay!") << std::endl;
+    std::cout << "sweep-hull: " << sweep_hull_indices.size()/3 << " triangles in " << sweep_hull_time << " ms" << (sweep_hull_valid ? "" : ", not Delaunay!") << std::endl;
+
+    return (advancing_front_valid && sweep_hull_valid) ? EXIT_SUCCESS : EXIT_FAILURE;
 
 }
 
@@ -231,6 +940,31 @@ void render::glfw_error_callback(int error, const char* description) {
 
 void render::glfw_key_callback(GLFWwindow* window, int key, int scancode, int action, int mods) {
 
+    glm::vec2
+        frame_size(camera.get_right() - camera.get_left(), camera.get_top() - camera.get_bottom()),
+        frame_center(camera.get_left() + frame_size.x/2.0f, camera.get_bottom() + frame_size.y/2.0f);
+
+    // Pan (arrows) and zoom (+/-) keep acting while the key is held.
+    if (action == GLFW_PRESS || action == GLFW_REPEAT) {
+
+        if (key == GLFW_KEY_LEFT || key == GLFW_KEY_RIGHT || key == GLFW_KEY_UP || key == GLFW_KEY_DOWN) {
+
+            glm::vec2 direction(
+                (key == GLFW_KEY_RIGHT) ? 1.0f : (key == GLFW_KEY_LEFT) ? -1.0f : 0.0f,
+                (key == GLFW_KEY_UP) ? 1.0f : (key == GLFW_KEY_DOWN) ? -1.0f : 0.0f
+            );
+            camera.pan(direction * frame_size * 0.1f);
+            camera_changed = true;
+
+        } else if (key == GLFW_KEY_EQUAL || key == GLFW_KEY_KP_ADD || key == GLFW_KEY_MINUS || key == GLFW_KEY_KP_SUBTRACT) {
+
+            camera.zoom((key == GLFW_KEY_EQUAL || key == GLFW_KEY_KP_ADD) ? 0.8f : 1.25f, frame_center);
+            camera_changed = true;
+
+        }
+
+    }
+
     if (action == GLFW_PRESS) {
 
         if (key == GLFW_KEY_ESCAPE) {
@@ -245,6 +979,21 @@ void render::glfw_key_callback(GLFWwindow* window, int key, int scancode, int ac
 
             render_groups_triangulations = !render_groups_triangulations;
 
+        } else if (key == GLFW_KEY_C) {
+
+            job.cancel();
+
+        } else if (key == GLFW_KEY_H && height_texture.is_created()) {
+
+            render_heights = !render_heights;
+
+        } else if (key == GLFW_KEY_V && groups_batch.get_group_count() > 0) {
+
+            // Cycling through the groups one at a time, then back to all of them.
+            solo_group = (solo_group + 1 < static_cast<long>(groups_batch.get_group_count())) ? solo_group + 1 : -1;
+            groups_batch.set_all_visible(solo_group == -1);
+            if (solo_group != -1) groups_batch.set_visible(solo_group, true);
+
         }
 
     }
@@ -255,4 +1004,23 @@ void render::glfw_framebuffer_size_callback (GLFWwindow* window, int width, int
 
     glViewport(0, 0, width, height);
 
+}
+
+void render::glfw_scroll_callback (GLFWwindow* window, double x_offset, double y_offset) {
+
+    // Zooming around the point under the cursor.
+    double cursor_x, cursor_y;
+    int width, height;
+
+    glfwGetCursorPos(window, &cursor_x, &cursor_y);
+    glfwGetWindowSize(window, &width, &height);
+    if (width <= 0 || height <= 0) return;
+
+    glm::vec2 center(
+        camera.get_left() + (camera.get_right() - camera.get_left()) * static_cast<float>(cursor_x / width),
+        camera.get_top() - (camera.get_top() - camera.get_bottom()) * static_cast<float>(cursor_y / height)
+    );
+    camera.zoom(std::pow(0.9f, static_cast<float>(y_offset)), center);
+    camera_changed = true;
+
 }
\ No newline at end of file
@@ -0,0 +1,65 @@
+#include "render/AttributeTexture.hpp"
+
+namespace triangulation {
+    namespace render {
+
+        AttributeTexture::AttributeTexture () : size(0) {}
+
+        AttributeTexture::~AttributeTexture () {
+
+            this->destroy();
+
+        }
+
+        bool AttributeTexture::is_created () const {
+
+            return this->texture.has_value();
+
+        }
+
+        std::size_t AttributeTexture::get_size () const {
+
+            return this->size;
+
+        }
+
+        void AttributeTexture::create (std::vector<float> const& values) {
+
+            GLuint id;
+
+            this->destroy();
+
+            glGenBuffers(1, &id);
+            this->buffer = id;
+            glGenTextures(1, &id);
+            this->texture = id;
+
+            glBindBuffer(GL_TEXTURE_BUFFER, this->buffer.value());
+            glBufferData(GL_TEXTURE_BUFFER, sizeof(float)*values.size(), values.data(), GL_STATIC_DRAW);
+            glBindTexture(GL_TEXTURE_BUFFER, this->texture.value());
+            glTexBuffer(GL_TEXTURE_BUFFER, GL_R32F, this->buffer.value());
+
+            this->size = values.size();
+
+        }
+
+        void AttributeTexture::bind (GLuint texture_unit) const {
+
+            glActiveTexture(GL_TEXTURE0 + texture_unit);
+            glBindTexture(GL_TEXTURE_BUFFER, this->texture.value_or(0));
+
+        }
+
+        void AttributeTexture::destroy () {
+
+            if (this->texture.has_value()) glDeleteTextures(1, &this->texture.value());
+            if (this->buffer.has_value()) glDeleteBuffers(1, &this->buffer.value());
+
+            this->texture.reset();
+            this->buffer.reset();
+            this->size = 0;
+
+        }
+
+    }
+}
@@ -0,0 +1,44 @@
+#ifndef TRIANGULATION_RENDER_ATTRIBUTETEXTURE_HPP_
+#define TRIANGULATION_RENDER_ATTRIBUTETEXTURE_HPP_
+
+#include <GL/glew.h>
+#include <optional>
+#include <vector>
+
+namespace triangulation {
+    namespace render {
+
+        // Buffer texture holding one float attribute per vertex (a channel of VertexAttributes), which the shaders fetch with
+        // gl_VertexID: for indexed draws without base vertex that is the index itself, so the triangulation indexes it directly.
+        class AttributeTexture {
+
+            private:
+
+                std::optional<GLuint> buffer, texture;
+                std::size_t size;
+
+            public:
+
+                AttributeTexture ();
+                ~AttributeTexture ();
+
+                AttributeTexture (AttributeTexture const&) = delete;
+                AttributeTexture& operator = (AttributeTexture const&) = delete;
+
+                bool is_created () const;
+                std::size_t get_size () const;
+
+                // Creates the buffer and its texture and uploads the values.
+                void create (std::vector<float> const& values);
+
+                // Binds the texture to the given texture unit.
+                void bind (GLuint texture_unit) const;
+
+                void destroy ();
+
+        };
+
+    }
+}
+
+#endif
@@ -0,0 +1,285 @@
+#include "render/FrameProfiler.hpp"
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+namespace triangulation {
+    namespace render {
+
+        FrameProfiler::FrameProfiler () : window_size(0), history_limit(0), frame(0), in_frame(false) {}
+
+        FrameProfiler::~FrameProfiler () {
+
+            this->destroy();
+
+        }
+
+        void FrameProfiler::create (std::vector<std::string> const& _phase_names, std::size_t _window_size, std::size_t _history_limit) {
+
+            this->destroy();
+
+            if (_window_size == 0) throw std::invalid_argument("Error: Frame profiler window size must be positive!");
+
+            this->phase_names = _phase_names;
+            this->window_size = _window_size;
+            this->history_limit = std::max(_history_limit, _window_size);
+
+            this->queries.assign(query_latency, std::vector<GLuint>(this->phase_names.size()));
+            this->queries_issued.assign(query_latency, std::vector<bool>(this->phase_names.size(), false));
+            this->queries_frame.assign(query_latency, std::nullopt);
+
+            for (auto& slot_queries : this->queries) {
+
+                glGenQueries(slot_queries.size(), slot_queries.data());
+
+            }
+
+        }
+
+        bool FrameProfiler::is_created () const {
+
+            return !this->queries.empty();
+
+        }
+
+        void FrameProfiler::begin_frame () {
+
+            if (!this->is_created()) throw std::runtime_error("Error: Failed to begin a frame on a frame profiler that was not created!");
+            if (this->in_frame) this->end_frame();
+
+            // The queries of this slot were issued query_latency frames ago, their results are almost certainly available.
+            std::size_t slot = this->frame % query_latency;
+            this->collect_queries(slot);
+            this->queries_frame[slot] = this->frame;
+
+            this->history.push_back({this->frame, -1.0, std::vector<double>(this->phase_names.size(), -1.0), std::vector<double>(this->phase_names.size(), -1.0)});
+            if (this->history.size() > this->history_limit) this->history.pop_front();
+
+            this->in_frame = true;
+            this->frame_start = std::chrono::steady_clock::now();
+
+        }
+
+        void FrameProfiler::end_frame () {
+
+            if (!this->in_frame) return;
+
+            this->end_phase();
+            this->history.back().frame_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - this->frame_start).count();
+            this->in_frame = false;
+            this->frame++;
+
+        }
+
+        void FrameProfiler::begin_phase (std::size_t phase) {
+
+            if (!this->in_frame) throw std::runtime_error("Error: Frame profiler phase begun outside of a frame!");
+            if (phase >= this->phase_names.size()) throw std::out_of_range("Error: Unknown frame profiler phase!");
+
+            this->end_phase();
+
+            std::size_t slot = this->frame % query_latency;
+            glBeginQuery(GL_TIME_ELAPSED, this->queries[slot][phase]);
+            this->queries_issued[slot][phase] = true;
+
+            this->active_phase = phase;
+            this->phase_start = std::chrono::steady_clock::now();
+
+        }
+
+        void FrameProfiler::end_phase () {
+
+            if (!this->active_phase.has_value()) return;
+
+            double elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - this->phase_start).count();
+            double& cpu_ms = this->history.back().cpu_ms[this->active_phase.value()];
+
+            glEndQuery(GL_TIME_ELAPSED);
+
+            // A phase begun several times in a frame accumulates its CPU time.
+            cpu_ms = (cpu_ms < 0.0) ? elapsed : cpu_ms + elapsed;
+            this->active_phase.reset();
+
+        }
+
+        void FrameProfiler::collect_queries (std::size_t slot) {
+
+            if (!this->queries_frame[slot].has_value()) return;
+
+            Record* record = this->find_record(this->queries_frame[slot].value());
+
+            for (std::size_t phase = 0; phase < this->phase_names.size(); phase++) {
+
+                if (!this->queries_issued[slot][phase]) continue;
+
+                GLuint64 elapsed_ns = 0;
+                glGetQueryObjectui64v(this->queries[slot][phase], GL_QUERY_RESULT, &elapsed_ns);
+                if (record != nullptr) record->gpu_ms[phase] = elapsed_ns / 1.0e6;
+                this->queries_issued[slot][phase] = false;
+
+            }
+
+            this->queries_frame[slot].reset();
+
+        }
+
+        FrameProfiler::Record* FrameProfiler::find_record (std::uint64_t _frame) {
+
+            if (this->history.empty() || _frame < this->history.front().frame || _frame > this->history.back().frame) return nullptr;
+            return &this->history[_frame - this->history.front().frame];
+
+        }
+
+        FrameProfiler::Statistics FrameProfiler::compute_statistics (std::optional<std::size_t> phase, bool gpu) const {
+
+            Statistics statistics;
+            std::size_t count = 0;
+
+            // Only the complete frames of the window are considered.
+            std::size_t end = this->history.size() - (this->in_frame ? 1 : 0);
+            std::size_t begin = (end > this->window_size) ? end - this->window_size : 0;
+
+            for (std::size_t i = begin; i < end; i++) {
+
+                Record const& record = this->history[i];
+                double value = !phase.has_value() ? record.frame_ms : (gpu ? record.gpu_ms[phase.value()] : record.cpu_ms[phase.value()]);
+
+                if (value < 0.0) continue;
+
+                statistics.min = (count == 0) ? value : std::min(statistics.min, value);
+                statistics.max = (count == 0) ? value : std::max(statistics.max, value);
+                statistics.mean += value;
+                count++;
+
+            }
+
+            if (count > 0) statistics.mean /= count;
+
+            return statistics;
+
+        }
+
+        std::size_t FrameProfiler::get_phase_count () const {
+
+            return this->phase_names.size();
+
+        }
+
+        std::string const& FrameProfiler::get_phase_name (std::size_t phase) const {
+
+            return this->phase_names.at(phase);
+
+        }
+
+        std::uint64_t FrameProfiler::get_frame_count () const {
+
+            return this->frame;
+
+        }
+
+        FrameProfiler::Statistics FrameProfiler::get_frame_statistics () const {
+
+            return this->compute_statistics(std::nullopt, false);
+
+        }
+
+        FrameProfiler::Statistics FrameProfiler::get_cpu_statistics (std::size_t phase) const {
+
+            return this->compute_statistics(phase, false);
+
+        }
+
+        FrameProfiler::Statistics FrameProfiler::get_gpu_statistics (std::size_t phase) const {
+
+            return this->compute_statistics(phase, true);
+
+        }
+
+        std::string FrameProfiler::get_summary () const {
+
+            std::ostringstream summary;
+            Statistics frame_statistics = this->get_frame_statistics();
+
+            summary << std::fixed << std::setprecision(2);
+            summary << frame_statistics.mean << " ms (" << std::setprecision(0) << ((frame_statistics.mean > 0.0) ? 1000.0 / frame_statistics.mean : 0.0) << " fps)";
+            summary << std::setprecision(2);
+
+            for (std::size_t phase = 0; phase < this->phase_names.size(); phase++) {
+
+                summary << " | " << this->phase_names[phase] << " cpu " << this->get_cpu_statistics(phase).mean << " gpu " << this->get_gpu_statistics(phase).mean;
+
+            }
+
+            return summary.str();
+
+        }
+
+        void FrameProfiler::write_csv (std::string const& path) {
+
+            for (std::size_t slot = 0; slot < this->queries_frame.size(); slot++) {
+
+                if (!this->in_frame || slot != this->frame % query_latency) this->collect_queries(slot);
+
+            }
+
+            std::ofstream file(path, std::ios::trunc);
+            if (!file.is_open()) throw std::runtime_error("Error: Failed to open file " + path + "!");
+
+            file << "frame,frame_ms";
+            for (auto const& name : this->phase_names) {
+
+                file << "," << name << "_cpu_ms," << name << "_gpu_ms";
+
+            }
+            file << "\n";
+
+            // Missing times (phases not run, or queries not read back yet) are left empty.
+            auto write_time = [&file] (double value) {
+
+                file << ",";
+                if (value >= 0.0) file << value;
+
+            };
+
+            for (auto const& record : this->history) {
+
+                if (record.frame_ms < 0.0) continue;
+
+                file << record.frame;
+                write_time(record.frame_ms);
+                for (std::size_t phase = 0; phase < this->phase_names.size(); phase++) {
+
+                    write_time(record.cpu_ms[phase]);
+                    write_time(record.gpu_ms[phase]);
+
+                }
+                file << "\n";
+
+            }
+
+            if (!file) throw std::runtime_error("Error: Failed to write file " + path + "!");
+
+        }
+
+        void FrameProfiler::destroy () {
+
+            if (this->in_frame) this->end_frame();
+
+            for (auto& slot_queries : this->queries) {
+
+                glDeleteQueries(slot_queries.size(), slot_queries.data());
+
+            }
+
+            this->queries.clear();
+            this->queries_issued.clear();
+            this->queries_frame.clear();
+            this->history.clear();
+            this->frame = 0;
+
+        }
+
+    }
+}
@@ -0,0 +1,106 @@
+#ifndef TRIANGULATION_RENDER_FRAMEPROFILER_HPP_
+#define TRIANGULATION_RENDER_FRAMEPROFILER_HPP_
+
+#include <GL/glew.h>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace triangulation {
+    namespace render {
+
+        // Measures the CPU and GPU time of the named phases of each frame.
+        // GPU times come from GL_TIME_ELAPSED queries read back a few frames later, so measuring never stalls the pipeline.
+        class FrameProfiler {
+
+            public:
+
+                // Frames of queries in flight before their results are read back.
+                static constexpr std::size_t query_latency = 4;
+
+                struct Statistics {
+
+                    double mean = 0.0;
+                    double min = 0.0;
+                    double max = 0.0;
+
+                };
+
+            private:
+
+                // Times of one frame in milliseconds, GPU times are negative until their queries are read back.
+                struct Record {
+
+                    std::uint64_t frame;
+                    double frame_ms;
+                    std::vector<double> cpu_ms;
+                    std::vector<double> gpu_ms;
+
+                };
+
+                std::vector<std::string> phase_names;
+                std::size_t window_size;
+                std::size_t history_limit;
+
+                // Queries indexed by [frame % query_latency][phase], with the frame that issued them.
+                std::vector<std::vector<GLuint>> queries;
+                std::vector<std::vector<bool>> queries_issued;
+                std::vector<std::optional<std::uint64_t>> queries_frame;
+
+                std::uint64_t frame;
+                bool in_frame;
+                std::optional<std::size_t> active_phase;
+                std::chrono::steady_clock::time_point frame_start;
+                std::chrono::steady_clock::time_point phase_start;
+
+                std::deque<Record> history;
+
+                void collect_queries (std::size_t slot);
+                Record* find_record (std::uint64_t frame);
+                Statistics compute_statistics (std::optional<std::size_t> phase, bool gpu) const;
+
+            public:
+
+                FrameProfiler ();
+                ~FrameProfiler ();
+
+                FrameProfiler (FrameProfiler const&) = delete;
+                FrameProfiler& operator = (FrameProfiler const&) = delete;
+
+                // Creates the queries; the statistics cover the last window_size frames, the export the last history_limit frames.
+                void create (std::vector<std::string> const& phase_names, std::size_t window_size = 120, std::size_t history_limit = 1 << 16);
+                bool is_created () const;
+
+                void begin_frame ();
+                void end_frame ();
+
+                // Phases of a frame are sequential: beginning a phase ends the previous one.
+                void begin_phase (std::size_t phase);
+                void end_phase ();
+
+                std::size_t get_phase_count () const;
+                std::string const& get_phase_name (std::size_t phase) const;
+                std::uint64_t get_frame_count () const;
+
+                // Rolling statistics over the last window_size frames, in milliseconds.
+                Statistics get_frame_statistics () const;
+                Statistics get_cpu_statistics (std::size_t phase) const;
+                Statistics get_gpu_statistics (std::size_t phase) const;
+
+                // One line summary of the rolling statistics, for logs and the window title.
+                std::string get_summary () const;
+
+                // Reads back the pending queries, then writes the recorded frames as CSV, one row per frame and a CPU and GPU column per phase.
+                void write_csv (std::string const& path);
+
+                void destroy ();
+
+        };
+
+    }
+}
+
+#endif
@@ -0,0 +1,119 @@
+#include "render/Framebuffer.hpp"
+#include <cstring>
+#include <stdexcept>
+
+namespace triangulation {
+    namespace render {
+
+        Framebuffer::Framebuffer () : width(0), height(0) {}
+
+        Framebuffer::~Framebuffer () {
+
+            this->destroy();
+
+        }
+
+        std::size_t Framebuffer::get_width () const {
+
+            return this->width;
+
+        }
+
+        std::size_t Framebuffer::get_height () const {
+
+            return this->height;
+
+        }
+
+        void Framebuffer::create (std::size_t _width, std::size_t _height) {
+
+            GLuint id;
+
+            this->destroy();
+            this->width = _width;
+            this->height = _height;
+
+            glGenFramebuffers(1, &id);
+            this->fbo = id;
+            glGenRenderbuffers(1, &id);
+            this->color_renderbuffer = id;
+
+            glBindRenderbuffer(GL_RENDERBUFFER, this->color_renderbuffer.value());
+            glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, this->width, this->height);
+            glBindFramebuffer(GL_FRAMEBUFFER, this->fbo.value());
+            glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, this->color_renderbuffer.value());
+
+            if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+
+                this->destroy();
+                throw std::runtime_error("Error: Framebuffer is incomplete!");
+
+            }
+
+            this->pixel_buffers.resize(readback_slots);
+            glGenBuffers(readback_slots, this->pixel_buffers.data());
+            for (auto const& buffer : this->pixel_buffers) {
+
+                glBindBuffer(GL_PIXEL_PACK_BUFFER, buffer);
+                glBufferData(GL_PIXEL_PACK_BUFFER, 4*this->width*this->height, nullptr, GL_STREAM_READ);
+
+            }
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+        }
+
+        void Framebuffer::bind () const {
+
+            if (!this->fbo.has_value()) throw std::runtime_error("Error: Failed to bind a framebuffer that was not created!");
+
+            glBindFramebuffer(GL_FRAMEBUFFER, this->fbo.value());
+            glViewport(0, 0, this->width, this->height);
+
+        }
+
+        void Framebuffer::begin_readback (std::size_t slot) const {
+
+            // With a pack buffer bound, glReadPixels only queues the copy.
+            glBindFramebuffer(GL_READ_FRAMEBUFFER, this->fbo.value());
+            glReadBuffer(GL_COLOR_ATTACHMENT0);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, this->pixel_buffers[slot]);
+            glPixelStorei(GL_PACK_ALIGNMENT, 1);
+            glReadPixels(0, 0, this->width, this->height, GL_RGBA, GL_UNSIGNED_BYTE, (GLvoid*)0);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+        }
+
+        std::vector<std::uint8_t> Framebuffer::finish_readback (std::size_t slot) const {
+
+            std::vector<std::uint8_t> pixels(4*this->width*this->height);
+
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, this->pixel_buffers[slot]);
+            const void* data = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, pixels.size(), GL_MAP_READ_BIT);
+            if (data == nullptr) {
+
+                glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+                throw std::runtime_error("Error: Failed to map the pixel buffer!");
+
+            }
+            std::memcpy(pixels.data(), data, pixels.size());
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+            glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+            return pixels;
+
+        }
+
+        void Framebuffer::destroy () {
+
+            if (!this->pixel_buffers.empty()) glDeleteBuffers(this->pixel_buffers.size(), this->pixel_buffers.data());
+            if (this->color_renderbuffer.has_value()) glDeleteRenderbuffers(1, &this->color_renderbuffer.value());
+            if (this->fbo.has_value()) glDeleteFramebuffers(1, &this->fbo.value());
+
+            this->pixel_buffers.clear();
+            this->color_renderbuffer.reset();
+            this->fbo.reset();
+
+        }
+
+    }
+}
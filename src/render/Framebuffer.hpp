@@ -0,0 +1,52 @@
+#ifndef TRIANGULATION_RENDER_FRAMEBUFFER_HPP_
+#define TRIANGULATION_RENDER_FRAMEBUFFER_HPP_
+
+#include <GL/glew.h>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace triangulation {
+    namespace render {
+
+        // Framebuffer object with an RGBA8 colour attachment, read back asynchronously through pixel buffer objects.
+        class Framebuffer {
+
+            private:
+
+                std::optional<GLuint> fbo, color_renderbuffer;
+                std::vector<GLuint> pixel_buffers;
+                std::size_t width, height;
+
+            public:
+
+                // Number of readbacks that can be in flight at the same time.
+                static constexpr std::size_t readback_slots = 2;
+
+                Framebuffer ();
+                ~Framebuffer ();
+
+                Framebuffer (Framebuffer const&) = delete;
+                Framebuffer& operator = (Framebuffer const&) = delete;
+
+                std::size_t get_width () const;
+                std::size_t get_height () const;
+
+                void create (std::size_t _width, std::size_t _height);
+
+                // Binds the framebuffer as the render target and sets the viewport to its size.
+                void bind () const;
+
+                // Starts copying the colour attachment into the pixel buffer of a slot; returns without waiting for the GPU.
+                void begin_readback (std::size_t slot) const;
+                // Waits for the copy started in the slot and returns the pixels (RGBA, bottom row first).
+                std::vector<std::uint8_t> finish_readback (std::size_t slot) const;
+
+                void destroy ();
+
+        };
+
+    }
+}
+
+#endif
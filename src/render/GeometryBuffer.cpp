@@ -0,0 +1,158 @@
+#include "render/GeometryBuffer.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace triangulation {
+    namespace render {
+
+        GeometryBuffer::GeometryBuffer (GLenum _usage) : usage(_usage), vertex_count(0), vertex_capacity(0), index_count(0), index_capacity(0) {}
+
+        GeometryBuffer::~GeometryBuffer () {
+
+            this->destroy();
+
+        }
+
+        GLuint GeometryBuffer::get_vao () const {
+
+            return this->vao.value_or(0);
+
+        }
+
+        GLuint GeometryBuffer::get_vbo () const {
+
+            return this->vbo.value_or(0);
+
+        }
+
+        std::size_t GeometryBuffer::get_vertex_count () const {
+
+            return this->vertex_count;
+
+        }
+
+        std::size_t GeometryBuffer::get_index_count () const {
+
+            return this->index_count;
+
+        }
+
+        void GeometryBuffer::create (GLuint attrib_location) {
+
+            GLuint ids[2];
+
+            glGenVertexArrays(1, &ids[0]);
+            this->vao = ids[0];
+            glGenBuffers(2, ids);
+            this->vbo = ids[0];
+            this->ebo = ids[1];
+
+            // The element buffer binding is part of the vertex array state.
+            glBindVertexArray(this->vao.value());
+            glBindBuffer(GL_ARRAY_BUFFER, this->vbo.value());
+            glEnableVertexAttribArray(attrib_location);
+            glVertexAttribPointer(attrib_location, 2, GL_FLOAT, GL_FALSE, 0, (GLvoid*)0);
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, this->ebo.value());
+            glBindVertexArray(0);
+
+        }
+
+        void GeometryBuffer::sync_vertices (std::vector<glm::vec2> const& vertices) {
+
+            if (!this->vbo.has_value()) throw std::runtime_error("Error: Failed to upload vertices to a geometry buffer that was not created!");
+            if (vertices.size() == this->vertex_count) return;
+
+            std::size_t first = (vertices.size() < this->vertex_count) ? 0 : this->vertex_count;
+
+            glBindBuffer(GL_ARRAY_BUFFER, this->vbo.value());
+
+            // Growing geometrically so appending is amortized; reallocating discards the old contents, so everything is sent again.
+            if (vertices.size() > this->vertex_capacity) {
+
+                this->vertex_capacity = std::max(vertices.size(), 2*this->vertex_capacity);
+                glBufferData(GL_ARRAY_BUFFER, sizeof(glm::vec2)*this->vertex_capacity, nullptr, this->usage);
+                first = 0;
+
+            }
+
+            glBufferSubData(GL_ARRAY_BUFFER, sizeof(glm::vec2)*first, sizeof(glm::vec2)*(vertices.size() - first), vertices.data() + first);
+            this->vertex_count = vertices.size();
+
+        }
+
+        void GeometryBuffer::sync_indices (std::vector<std::uint32_t> const& indices) {
+
+            if (!this->ebo.has_value()) throw std::runtime_error("Error: Failed to upload indices to a geometry buffer that was not created!");
+            if (indices.size() == this->index_count) return;
+
+            std::size_t first = (indices.size() < this->index_count) ? 0 : this->index_count;
+
+            glBindVertexArray(this->vao.value());
+
+            if (indices.size() > this->index_capacity) {
+
+                this->index_capacity = std::max(indices.size(), 2*this->index_capacity);
+                glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(std::uint32_t)*this->index_capacity, nullptr, this->usage);
+                first = 0;
+
+            }
+
+            glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, sizeof(std::uint32_t)*first, sizeof(std::uint32_t)*(indices.size() - first), indices.data() + first);
+            this->index_count = indices.size();
+            glBindVertexArray(0);
+
+        }
+
+        void GeometryBuffer::stream_vertices (std::vector<glm::vec2> const& vertices) {
+
+            if (!this->vbo.has_value()) throw std::runtime_error("Error: Failed to upload vertices to a geometry buffer that was not created!");
+
+            glBindBuffer(GL_ARRAY_BUFFER, this->vbo.value());
+
+            this->vertex_capacity = std::max(vertices.size(), this->vertex_capacity);
+            glBufferData(GL_ARRAY_BUFFER, sizeof(glm::vec2)*this->vertex_capacity, nullptr, this->usage);
+            glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(glm::vec2)*vertices.size(), vertices.data());
+            this->vertex_count = vertices.size();
+
+        }
+
+        void GeometryBuffer::invalidate () {
+
+            this->vertex_count = 0;
+            this->index_count = 0;
+
+        }
+
+        void GeometryBuffer::draw_elements (GLenum mode) const {
+
+            if (this->index_count == 0) return;
+
+            glBindVertexArray(this->get_vao());
+            glDrawElements(mode, this->index_count, GL_UNSIGNED_INT, (GLvoid*)0);
+
+        }
+
+        void GeometryBuffer::draw_arrays (GLenum mode) const {
+
+            if (this->vertex_count == 0) return;
+
+            glBindVertexArray(this->get_vao());
+            glDrawArrays(mode, 0, this->vertex_count);
+
+        }
+
+        void GeometryBuffer::destroy () {
+
+            if (this->vbo.has_value()) glDeleteBuffers(1, &this->vbo.value());
+            if (this->ebo.has_value()) glDeleteBuffers(1, &this->ebo.value());
+            if (this->vao.has_value()) glDeleteVertexArrays(1, &this->vao.value());
+
+            this->vao.reset();
+            this->vbo.reset();
+            this->ebo.reset();
+            this->vertex_count = this->vertex_capacity = this->index_count = this->index_capacity = 0;
+
+        }
+
+    }
+}
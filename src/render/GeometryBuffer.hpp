@@ -0,0 +1,66 @@
+#ifndef TRIANGULATION_RENDER_GEOMETRYBUFFER_HPP_
+#define TRIANGULATION_RENDER_GEOMETRYBUFFER_HPP_
+
+#include <GL/glew.h>
+#include <glm/vec2.hpp>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace triangulation {
+    namespace render {
+
+        // Vertex array with a resident vertex buffer and an optional index buffer.
+        // Data is only uploaded when it changes, so static geometry is sent to the GPU once.
+        class GeometryBuffer {
+
+            private:
+
+                std::optional<GLuint> vao, vbo, ebo;
+                GLenum usage;
+                // Number of elements uploaded and allocated in each buffer.
+                std::size_t vertex_count, vertex_capacity, index_count, index_capacity;
+
+            public:
+
+                GeometryBuffer (GLenum _usage = GL_STATIC_DRAW);
+                ~GeometryBuffer ();
+
+                GeometryBuffer (GeometryBuffer const&) = delete;
+                GeometryBuffer& operator = (GeometryBuffer const&) = delete;
+
+                GLuint get_vao () const;
+                GLuint get_vbo () const;
+                std::size_t get_vertex_count () const;
+                std::size_t get_index_count () const;
+
+                // Creates the buffers, binding the vertex buffer to a vec2 attribute.
+                void create (GLuint attrib_location);
+
+                // Uploads the vertices appended since the last call.
+                // The vertices are expected to only grow: if the vector shrank, or after invalidate(), everything is uploaded again.
+                void sync_vertices (std::vector<glm::vec2> const& vertices);
+                // Same as sync_vertices, for the index buffer.
+                void sync_indices (std::vector<std::uint32_t> const& indices);
+
+                // Replaces all vertices, orphaning the previous storage so the driver does not wait for draws still using it.
+                // Meant for data that changes completely between frames.
+                void stream_vertices (std::vector<glm::vec2> const& vertices);
+
+                // Forces the next sync to upload everything.
+                void invalidate ();
+
+                // Draws the indexed geometry.
+                void draw_elements (GLenum mode) const;
+                // Draws the vertices in order, ignoring the index buffer.
+                void draw_arrays (GLenum mode) const;
+
+                // Deletes the buffers and the vertex array.
+                void destroy ();
+
+        };
+
+    }
+}
+
+#endif
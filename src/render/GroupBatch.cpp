@@ -0,0 +1,201 @@
+#include "render/GroupBatch.hpp"
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <glm/glm.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+namespace triangulation {
+    namespace render {
+
+        GroupBatch::GroupBatch () : need_to_update_draw_lists(true) {}
+
+        GroupBatch::~GroupBatch () {
+
+            this->destroy();
+
+        }
+
+        std::size_t GroupBatch::get_group_count () const {
+
+            return this->base_vertices.size();
+
+        }
+
+        void GroupBatch::create (std::vector<std::vector<glm::vec2>> const& groups, GLuint position_location, GLuint group_location) {
+
+            std::vector<glm::vec2> positions;
+            std::vector<GLuint> group_ids;
+            std::vector<glm::vec4> colors;
+            std::size_t index_total = 0;
+            GLuint ids[4];
+
+            this->destroy();
+
+            // Building the offset tables. A triangulation of n points has at most 2n - 5 triangles.
+            for (std::size_t i = 0; i < groups.size(); ++i) {
+
+                this->base_vertices.push_back(positions.size());
+                this->first_indices.push_back(index_total);
+                this->index_capacities.push_back(6*groups[i].size());
+                this->index_counts.push_back(0);
+                this->visible.push_back(true);
+                index_total += this->index_capacities.back();
+
+                positions.insert(positions.end(), groups[i].begin(), groups[i].end());
+                group_ids.insert(group_ids.end(), groups[i].size(), i);
+
+                // Spreading the hues with the golden ratio so neighbouring groups get distinct colours.
+                float hue = std::fmod(i*0.618034f, 1.0f);
+                glm::vec3 rgb = glm::clamp(glm::vec3(std::fabs(hue*6.0f - 3.0f) - 1.0f, 2.0f - std::fabs(hue*6.0f - 2.0f), 2.0f - std::fabs(hue*6.0f - 4.0f)), glm::vec3(0.0f), glm::vec3(1.0f));
+                colors.emplace_back(glm::mix(rgb, glm::vec3(1.0f), 0.3f), 1.0f);
+
+            }
+
+            glGenVertexArrays(1, &ids[0]);
+            this->vao = ids[0];
+            glGenBuffers(4, ids);
+            this->position_vbo = ids[0];
+            this->group_vbo = ids[1];
+            this->ebo = ids[2];
+            this->color_buffer = ids[3];
+            glGenTextures(1, &ids[0]);
+            this->color_texture = ids[0];
+
+            glBindVertexArray(this->vao.value());
+
+            glBindBuffer(GL_ARRAY_BUFFER, this->position_vbo.value());
+            glBufferData(GL_ARRAY_BUFFER, sizeof(glm::vec2)*positions.size(), positions.data(), GL_STATIC_DRAW);
+            glEnableVertexAttribArray(position_location);
+            glVertexAttribPointer(position_location, 2, GL_FLOAT, GL_FALSE, 0, (GLvoid*)0);
+
+            glBindBuffer(GL_ARRAY_BUFFER, this->group_vbo.value());
+            glBufferData(GL_ARRAY_BUFFER, sizeof(GLuint)*group_ids.size(), group_ids.data(), GL_STATIC_DRAW);
+            glEnableVertexAttribArray(group_location);
+            glVertexAttribIPointer(group_location, 1, GL_UNSIGNED_INT, 0, (GLvoid*)0);
+
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, this->ebo.value());
+            glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(std::uint32_t)*index_total, nullptr, GL_STATIC_DRAW);
+
+            glBindVertexArray(0);
+
+            glBindBuffer(GL_TEXTURE_BUFFER, this->color_buffer.value());
+            glBufferData(GL_TEXTURE_BUFFER, sizeof(glm::vec4)*colors.size(), colors.data(), GL_STATIC_DRAW);
+            glBindTexture(GL_TEXTURE_BUFFER, this->color_texture.value());
+            glTexBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, this->color_buffer.value());
+
+            this->need_to_update_draw_lists = true;
+
+        }
+
+        void GroupBatch::sync_indices (std::size_t group, std::vector<std::uint32_t> const& indices) {
+
+            if (!this->ebo.has_value()) throw std::runtime_error("Error: Failed to upload indices to a group batch that was not created!");
+            if (indices.size() > this->index_capacities[group]) throw std::runtime_error("Error: Group " + std::to_string(group) + " has more indices than its range in the batch!");
+            if (indices.size() == this->index_counts[group]) return;
+
+            std::size_t first = (indices.size() < this->index_counts[group]) ? 0 : this->index_counts[group];
+
+            glBindVertexArray(this->vao.value());
+            glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, sizeof(std::uint32_t)*(this->first_indices[group] + first), sizeof(std::uint32_t)*(indices.size() - first), indices.data() + first);
+            glBindVertexArray(0);
+
+            this->index_counts[group] = indices.size();
+            this->need_to_update_draw_lists = true;
+
+        }
+
+        void GroupBatch::set_color (std::size_t group, glm::vec4 color) {
+
+            glBindBuffer(GL_TEXTURE_BUFFER, this->color_buffer.value());
+            glBufferSubData(GL_TEXTURE_BUFFER, sizeof(glm::vec4)*group, sizeof(glm::vec4), glm::value_ptr(color));
+
+        }
+
+        bool GroupBatch::is_visible (std::size_t group) const {
+
+            return this->visible[group];
+
+        }
+
+        void GroupBatch::set_visible (std::size_t group, bool is_visible) {
+
+            this->visible[group] = is_visible;
+            this->need_to_update_draw_lists = true;
+
+        }
+
+        void GroupBatch::set_all_visible (bool is_visible) {
+
+            this->visible.assign(this->visible.size(), is_visible);
+            this->need_to_update_draw_lists = true;
+
+        }
+
+        void GroupBatch::update_draw_lists () {
+
+            this->draw_counts.clear();
+            this->draw_offsets.clear();
+            this->draw_base_vertices.clear();
+
+            for (std::size_t i = 0; i < this->base_vertices.size(); ++i) {
+
+                if (this->visible[i] && this->index_counts[i] > 0) {
+
+                    this->draw_counts.push_back(this->index_counts[i]);
+                    this->draw_offsets.push_back((const void*)(sizeof(std::uint32_t)*this->first_indices[i]));
+                    this->draw_base_vertices.push_back(this->base_vertices[i]);
+
+                }
+
+            }
+
+            this->need_to_update_draw_lists = false;
+
+        }
+
+        void GroupBatch::bind_colors (GLuint texture_unit) const {
+
+            glActiveTexture(GL_TEXTURE0 + texture_unit);
+            glBindTexture(GL_TEXTURE_BUFFER, this->color_texture.value_or(0));
+
+        }
+
+        void GroupBatch::draw (GLenum mode) {
+
+            if (!this->vao.has_value()) return;
+            if (this->need_to_update_draw_lists) this->update_draw_lists();
+            if (this->draw_counts.empty()) return;
+
+            glBindVertexArray(this->vao.value());
+            glMultiDrawElementsBaseVertex(mode, this->draw_counts.data(), GL_UNSIGNED_INT, this->draw_offsets.data(), this->draw_counts.size(), this->draw_base_vertices.data());
+
+        }
+
+        void GroupBatch::destroy () {
+
+            if (this->color_texture.has_value()) glDeleteTextures(1, &this->color_texture.value());
+            if (this->position_vbo.has_value()) glDeleteBuffers(1, &this->position_vbo.value());
+            if (this->group_vbo.has_value()) glDeleteBuffers(1, &this->group_vbo.value());
+            if (this->ebo.has_value()) glDeleteBuffers(1, &this->ebo.value());
+            if (this->color_buffer.has_value()) glDeleteBuffers(1, &this->color_buffer.value());
+            if (this->vao.has_value()) glDeleteVertexArrays(1, &this->vao.value());
+
+            this->vao.reset();
+            this->position_vbo.reset();
+            this->group_vbo.reset();
+            this->ebo.reset();
+            this->color_buffer.reset();
+            this->color_texture.reset();
+
+            this->base_vertices.clear();
+            this->first_indices.clear();
+            this->index_capacities.clear();
+            this->index_counts.clear();
+            this->visible.clear();
+            this->need_to_update_draw_lists = true;
+
+        }
+
+    }
+}
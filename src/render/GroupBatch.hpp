@@ -0,0 +1,72 @@
+#ifndef TRIANGULATION_RENDER_GROUPBATCH_HPP_
+#define TRIANGULATION_RENDER_GROUPBATCH_HPP_
+
+#include <GL/glew.h>
+#include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace triangulation {
+    namespace render {
+
+        // Packs the geometry of many groups in shared buffers and draws all of them with a single glMultiDrawElementsBaseVertex call.
+        // Each group owns a range of the vertex buffer and a fixed range of the index buffer, large enough for a triangulation of its points.
+        // Every vertex stores the index of its group, which the shaders use to fetch the group colour from a buffer texture.
+        class GroupBatch {
+
+            private:
+
+                std::optional<GLuint> vao, position_vbo, group_vbo, ebo, color_buffer, color_texture;
+
+                // Offset tables.
+                std::vector<GLint> base_vertices;
+                std::vector<std::size_t> first_indices, index_capacities, index_counts;
+                std::vector<bool> visible;
+
+                // Arguments of the multi-draw call, rebuilt only when visibility or index counts change.
+                std::vector<GLsizei> draw_counts;
+                std::vector<const void*> draw_offsets;
+                std::vector<GLint> draw_base_vertices;
+                bool need_to_update_draw_lists;
+
+                void update_draw_lists ();
+
+            public:
+
+                GroupBatch ();
+                ~GroupBatch ();
+
+                GroupBatch (GroupBatch const&) = delete;
+                GroupBatch& operator = (GroupBatch const&) = delete;
+
+                std::size_t get_group_count () const;
+
+                // Creates the buffers and uploads the points of every group.
+                void create (std::vector<std::vector<glm::vec2>> const& groups, GLuint position_location, GLuint group_location);
+
+                // Uploads the triangle indices (local to the group points) appended since the last call.
+                void sync_indices (std::size_t group, std::vector<std::uint32_t> const& indices);
+
+                void set_color (std::size_t group, glm::vec4 color);
+
+                // Visibility only changes the draw lists, the buffers are not touched.
+                bool is_visible (std::size_t group) const;
+                void set_visible (std::size_t group, bool is_visible);
+                void set_all_visible (bool is_visible);
+
+                // Binds the colour buffer texture to the given texture unit.
+                void bind_colors (GLuint texture_unit) const;
+
+                // Draws all visible groups with one call.
+                void draw (GLenum mode);
+
+                void destroy ();
+
+        };
+
+    }
+}
+
+#endif
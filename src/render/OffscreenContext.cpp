@@ -0,0 +1,86 @@
+#include "render/OffscreenContext.hpp"
+#include <GL/glew.h>
+#include <EGL/eglext.h>
+#include <stdexcept>
+#include <string>
+
+namespace triangulation {
+    namespace render {
+
+        OffscreenContext::OffscreenContext () : display(EGL_NO_DISPLAY), context(EGL_NO_CONTEXT) {}
+
+        OffscreenContext::~OffscreenContext () {
+
+            this->destroy();
+
+        }
+
+        void OffscreenContext::create (int major_version, int minor_version) {
+
+            EGLint major, minor, config_count = 0;
+            EGLConfig config = nullptr;
+
+            this->destroy();
+
+            // Preferring the surfaceless platform, which needs neither X11 nor Wayland.
+            auto get_platform_display = (PFNEGLGETPLATFORMDISPLAYEXTPROC) eglGetProcAddress("eglGetPlatformDisplayEXT");
+            if (get_platform_display != nullptr) this->display = get_platform_display(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+            if (this->display == EGL_NO_DISPLAY) this->display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+            if (this->display == EGL_NO_DISPLAY) throw std::runtime_error("EGL: Failed to get a display!");
+
+            if (!eglInitialize(this->display, &major, &minor)) throw std::runtime_error("EGL: Failed to initialize!");
+            if (!eglBindAPI(EGL_OPENGL_API)) throw std::runtime_error("EGL: OpenGL API is not supported!");
+
+            const EGLint config_attributes[] = {
+
+                EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+                EGL_NONE
+
+            };
+            eglChooseConfig(this->display, config_attributes, &config, 1, &config_count);
+            if (config_count == 0) config = nullptr; // EGL_NO_CONFIG_KHR
+
+            const EGLint context_attributes[] = {
+
+                EGL_CONTEXT_MAJOR_VERSION, major_version,
+                EGL_CONTEXT_MINOR_VERSION, minor_version,
+                EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+                EGL_NONE
+
+            };
+            this->context = eglCreateContext(this->display, config, EGL_NO_CONTEXT, context_attributes);
+            if (this->context == EGL_NO_CONTEXT) throw std::runtime_error("EGL: Failed to create an OpenGL " + std::to_string(major_version) + "." + std::to_string(minor_version) + " context!");
+
+            this->make_current();
+
+            // GLEW reports a missing GLX display when there is no X server, but the OpenGL entry points are still loaded.
+            glewExperimental = GL_TRUE;
+            GLenum glew_status = glewInit();
+#ifdef GLEW_ERROR_NO_GLX_DISPLAY
+            if (glew_status == GLEW_ERROR_NO_GLX_DISPLAY) glew_status = GLEW_OK;
+#endif
+            if (glew_status != GLEW_OK) throw std::runtime_error(std::string("GLEW: ") + (const char*) glewGetErrorString(glew_status));
+
+        }
+
+        void OffscreenContext::make_current () const {
+
+            if (!eglMakeCurrent(this->display, EGL_NO_SURFACE, EGL_NO_SURFACE, this->context)) throw std::runtime_error("EGL: Failed to make the context current!");
+
+        }
+
+        void OffscreenContext::destroy () {
+
+            if (this->display == EGL_NO_DISPLAY) return;
+
+            eglMakeCurrent(this->display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+            if (this->context != EGL_NO_CONTEXT) eglDestroyContext(this->display, this->context);
+            eglTerminate(this->display);
+
+            this->context = EGL_NO_CONTEXT;
+            this->display = EGL_NO_DISPLAY;
+
+        }
+
+    }
+}
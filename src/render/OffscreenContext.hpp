@@ -0,0 +1,39 @@
+#ifndef TRIANGULATION_RENDER_OFFSCREENCONTEXT_HPP_
+#define TRIANGULATION_RENDER_OFFSCREENCONTEXT_HPP_
+
+#include <EGL/egl.h>
+
+namespace triangulation {
+    namespace render {
+
+        // OpenGL context without any window or display server, created through EGL on Mesa's surfaceless platform.
+        // With LIBGL_ALWAYS_SOFTWARE=1 Mesa renders it with its software rasterizer (llvmpipe).
+        // Rendering must target a framebuffer object, since the context has no default framebuffer.
+        class OffscreenContext {
+
+            private:
+
+                EGLDisplay display;
+                EGLContext context;
+
+            public:
+
+                OffscreenContext ();
+                ~OffscreenContext ();
+
+                OffscreenContext (OffscreenContext const&) = delete;
+                OffscreenContext& operator = (OffscreenContext const&) = delete;
+
+                // Creates a core profile context of the given version, makes it current and loads the OpenGL API.
+                void create (int major_version = 3, int minor_version = 3);
+
+                void make_current () const;
+
+                void destroy ();
+
+        };
+
+    }
+}
+
+#endif
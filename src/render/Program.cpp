@@ -1,5 +1,11 @@
 #include "render/Program.hpp"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <glm/gtc/type_ptr.hpp>
 
 namespace triangulation {
     namespace render {
@@ -79,6 +85,275 @@ namespace triangulation {
 
             }
 
+            this->reflect();
+
+        }
+
+        void Program::build (std::vector<std::pair<GLenum, std::string>> const& shader_paths, std::string const& cache_dir) {
+
+            std::vector<std::string> sources;
+            std::string cache_path;
+            bool use_cache = !cache_dir.empty() && (GLEW_VERSION_4_1 || GLEW_ARB_get_program_binary);
+
+            for (auto const& shader_path : shader_paths) {
+
+                sources.push_back(Shader::read_source(shader_path.second));
+
+            }
+
+            if (use_cache) {
+
+                GLint format_count = 0;
+                glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &format_count);
+                use_cache = format_count > 0;
+
+            }
+
+            this->destroy();
+            this->create();
+
+            if (use_cache) {
+
+                // FNV-1a hash of the shader types and sources and of the driver identification.
+                std::uint64_t hash = 14695981039346656037ull;
+                auto hash_bytes = [&hash] (const void* data, std::size_t size) {
+
+                    for (std::size_t i = 0; i < size; ++i) {
+
+                        hash ^= static_cast<const std::uint8_t*>(data)[i];
+                        hash *= 1099511628211ull;
+
+                    }
+
+                };
+
+                for (std::size_t i = 0; i < sources.size(); ++i) {
+
+                    hash_bytes(&shader_paths[i].first, sizeof(GLenum));
+                    hash_bytes(sources[i].data(), sources[i].size());
+
+                }
+                for (GLenum name : {GL_VENDOR, GL_RENDERER, GL_VERSION}) {
+
+                    const char* driver_string = (const char*) glGetString(name);
+                    if (driver_string != nullptr) hash_bytes(driver_string, std::strlen(driver_string));
+
+                }
+
+                std::ostringstream file_name;
+                file_name << std::hex << hash << ".bin";
+                cache_path = (std::filesystem::path(cache_dir) / file_name.str()).string();
+
+                if (this->load_binary(cache_path)) return;
+
+            }
+
+            // Compiling from source.
+            std::vector<Shader> shaders;
+            shaders.reserve(shader_paths.size());
+
+            for (std::size_t i = 0; i < shader_paths.size(); ++i) {
+
+                shaders.emplace_back(shader_paths[i].first);
+                shaders.back().compile_source(sources[i], shader_paths[i].second);
+                this->attach(shaders.back().get_id());
+
+            }
+
+            if (use_cache) glProgramParameteri(this->get_id(), GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+
+            this->link();
+
+            for (auto const& shader : shaders) {
+
+                this->detach(shader.get_id());
+
+            }
+
+            if (use_cache) {
+
+                try {
+
+                    std::filesystem::create_directories(cache_dir);
+                    this->save_binary(cache_path);
+
+                } catch (std::exception const& e) {
+
+                    // The cache is only an optimization.
+                    std::cout << "Program binary cache: " << e.what() << std::endl;
+
+                }
+
+            }
+
+        }
+
+        bool Program::load_binary (std::string const& path) {
+
+            std::ifstream file(path, std::ios::binary);
+            if (!file) return false;
+
+            GLenum format;
+            std::vector<char> binary;
+
+            file.read(reinterpret_cast<char*>(&format), sizeof(format));
+            binary.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+            if (!file.eof() || binary.empty()) return false;
+
+            glProgramBinary(this->get_id(), format, binary.data(), binary.size());
+
+            // The driver rejects binaries from other versions or hardware.
+            GLint linking_status = GL_FALSE;
+            glGetProgramiv(this->get_id(), GL_LINK_STATUS, &linking_status);
+            if (!linking_status) return false;
+
+            this->reflect();
+
+            return true;
+
+        }
+
+        void Program::save_binary (std::string const& path) const {
+
+            GLint length = 0;
+            GLenum format;
+            std::vector<char> binary;
+
+            glGetProgramiv(this->get_id(), GL_PROGRAM_BINARY_LENGTH, &length);
+            if (length <= 0) throw std::runtime_error("Program " + std::to_string(this->get_id()) + " has no retrievable binary!");
+
+            binary.resize(length);
+            glGetProgramBinary(this->get_id(), length, nullptr, &format, binary.data());
+
+            std::ofstream file(path, std::ios::binary | std::ios::trunc);
+            if (!file) throw std::runtime_error("Failed to open file \"" + path + "\"!");
+
+            file.write(reinterpret_cast<const char*>(&format), sizeof(format));
+            file.write(binary.data(), binary.size());
+
+        }
+
+        void Program::reflect () {
+
+            GLint count = 0, max_name_length = 0;
+            std::string name;
+
+            this->uniforms.clear();
+            this->uniform_handles.clear();
+            this->uniform_blocks.clear();
+
+            glGetProgramiv(this->get_id(), GL_ACTIVE_UNIFORMS, &count);
+            glGetProgramiv(this->get_id(), GL_ACTIVE_UNIFORM_MAX_LENGTH, &max_name_length);
+            name.resize(max_name_length);
+
+            for (GLint i = 0; i < count; ++i) {
+
+                Uniform uniform;
+                GLsizei length = 0;
+
+                glGetActiveUniform(this->get_id(), i, max_name_length, &length, &uniform.size, &uniform.type, name.data());
+                uniform.name = name.substr(0, length);
+                uniform.location = glGetUniformLocation(this->get_id(), uniform.name.c_str());
+
+                // Uniforms inside blocks have no location, they are set through buffers.
+                if (uniform.location == -1) continue;
+
+                // Arrays are reported as "name[0]"; they can also be looked up by the plain name.
+                if (uniform.name.size() > 3 && uniform.name.compare(uniform.name.size() - 3, 3, "[0]") == 0) {
+
+                    this->uniform_handles[uniform.name.substr(0, uniform.name.size() - 3)] = this->uniforms.size();
+
+                }
+                this->uniform_handles[uniform.name] = this->uniforms.size();
+                this->uniforms.push_back(std::move(uniform));
+
+            }
+
+            glGetProgramiv(this->get_id(), GL_ACTIVE_UNIFORM_BLOCKS, &count);
+            glGetProgramiv(this->get_id(), GL_ACTIVE_UNIFORM_BLOCK_MAX_NAME_LENGTH, &max_name_length);
+            name.resize(max_name_length);
+
+            for (GLint i = 0; i < count; ++i) {
+
+                GLsizei length = 0;
+
+                glGetActiveUniformBlockName(this->get_id(), i, max_name_length, &length, name.data());
+                this->uniform_blocks[name.substr(0, length)] = i;
+
+            }
+
+        }
+
+        Program::UniformHandle Program::get_uniform (std::string const& name) const {
+
+            auto it = this->uniform_handles.find(name);
+
+            return (it != this->uniform_handles.end()) ? it->second : invalid_uniform;
+
+        }
+
+        bool Program::update_cache (UniformHandle handle, const void* value, std::size_t size) {
+
+            std::vector<std::uint8_t>& cached_value = this->uniforms[handle].value;
+
+            if (cached_value.size() == size && std::memcmp(cached_value.data(), value, size) == 0) return false;
+
+            cached_value.resize(size);
+            std::memcpy(cached_value.data(), value, size);
+
+            return true;
+
+        }
+
+        void Program::set_uniform (UniformHandle handle, GLint value) {
+
+            if (handle >= this->uniforms.size() || !this->update_cache(handle, &value, sizeof(value))) return;
+            glUniform1i(this->uniforms[handle].location, value);
+
+        }
+
+        void Program::set_uniform (UniformHandle handle, GLfloat value) {
+
+            if (handle >= this->uniforms.size() || !this->update_cache(handle, &value, sizeof(value))) return;
+            glUniform1f(this->uniforms[handle].location, value);
+
+        }
+
+        void Program::set_uniform (UniformHandle handle, glm::vec2 const& value) {
+
+            if (handle >= this->uniforms.size() || !this->update_cache(handle, glm::value_ptr(value), sizeof(GLfloat)*2)) return;
+            glUniform2fv(this->uniforms[handle].location, 1, glm::value_ptr(value));
+
+        }
+
+        void Program::set_uniform (UniformHandle handle, glm::vec4 const& value) {
+
+            if (handle >= this->uniforms.size() || !this->update_cache(handle, glm::value_ptr(value), sizeof(GLfloat)*4)) return;
+            glUniform4fv(this->uniforms[handle].location, 1, glm::value_ptr(value));
+
+        }
+
+        void Program::set_uniform (UniformHandle handle, glm::mat4 const& value) {
+
+            if (handle >= this->uniforms.size() || !this->update_cache(handle, glm::value_ptr(value), sizeof(GLfloat)*16)) return;
+            glUniformMatrix4fv(this->uniforms[handle].location, 1, GL_FALSE, glm::value_ptr(value));
+
+        }
+
+        bool Program::has_uniform_block (std::string const& name) const {
+
+            return this->uniform_blocks.find(name) != this->uniform_blocks.end();
+
+        }
+
+        void Program::bind_uniform_block (std::string const& name, GLuint binding) const {
+
+            auto it = this->uniform_blocks.find(name);
+
+            if (it == this->uniform_blocks.end()) throw std::runtime_error("Error: Program " + std::to_string(this->get_id()) + " has no active uniform block \"" + name + "\"!");
+
+            glUniformBlockBinding(this->get_id(), it->second, binding);
+
         }
 
         void Program::use() const {
@@ -91,6 +366,11 @@ namespace triangulation {
         void Program::destroy () {
 
             if (this->id.has_value()) glDeleteProgram(this->get_id());
+            this->id.reset();
+
+            this->uniforms.clear();
+            this->uniform_handles.clear();
+            this->uniform_blocks.clear();
 
         }
 
@@ -3,7 +3,15 @@
 
 #include <GL/glew.h>
 #include "render/Shader.hpp"
+#include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
+#include <glm/mat4x4.hpp>
+#include <cstdint>
+#include <limits>
 #include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace triangulation {
@@ -11,10 +19,43 @@ namespace triangulation {
 
         class Program {
 
+            public:
+
+                // Index of an active uniform in the reflection table, looked up once by name with get_uniform().
+                using UniformHandle = std::size_t;
+                static constexpr UniformHandle invalid_uniform = std::numeric_limits<UniformHandle>::max();
+
             private:
 
+                struct Uniform {
+
+                    std::string name;
+                    GLint location;
+                    GLenum type;
+                    GLint size;
+                    // Last value uploaded, used to skip redundant uploads.
+                    std::vector<std::uint8_t> value;
+
+                };
+
                 std::optional<GLuint> id;
 
+                // Filled by link().
+                std::vector<Uniform> uniforms;
+                std::unordered_map<std::string, UniformHandle> uniform_handles;
+                std::unordered_map<std::string, GLuint> uniform_blocks;
+
+                // Queries the active uniforms and uniform blocks of the linked program.
+                void reflect ();
+
+                // Tries to link the program from a binary previously saved to path. Returns false if there is no file or the driver rejects it.
+                bool load_binary (std::string const& path);
+                // Saves the binary of the linked program to path.
+                void save_binary (std::string const& path) const;
+
+                // Returns false if the value is the same as the last one uploaded to the uniform.
+                bool update_cache (UniformHandle handle, const void* value, std::size_t size);
+
             public:
 
                 Program ();
@@ -44,6 +85,28 @@ namespace triangulation {
                 // Bind the program to be used.
                 void use() const;
 
+                // Creates and links the program from shader files (pairs of shader type and path).
+                // The linked binary is cached in cache_dir, keyed by a hash of the sources and of the driver strings,
+                // and reloaded on later runs instead of compiling. If the driver rejects the binary, the sources are compiled.
+                // An empty cache_dir, or a driver without program binary support, always compiles.
+                void build (std::vector<std::pair<GLenum, std::string>> const& shader_paths, std::string const& cache_dir);
+
+                // Returns the handle of an active uniform, or invalid_uniform if the program has no such uniform.
+                // Setting an invalid handle does nothing.
+                UniformHandle get_uniform (std::string const& name) const;
+
+                // Typed setters. The program must be in use; values equal to the last one uploaded are skipped.
+                void set_uniform (UniformHandle handle, GLint value);
+                void set_uniform (UniformHandle handle, GLfloat value);
+                void set_uniform (UniformHandle handle, glm::vec2 const& value);
+                void set_uniform (UniformHandle handle, glm::vec4 const& value);
+                void set_uniform (UniformHandle handle, glm::mat4 const& value);
+
+                // Returns true if the program has an active uniform block with this name.
+                bool has_uniform_block (std::string const& name) const;
+                // Assigns a uniform block to a uniform buffer binding point.
+                void bind_uniform_block (std::string const& name, GLuint binding) const;
+
                 // Deletes the program.
                 void destroy ();
 
@@ -26,26 +26,38 @@ namespace triangulation {
 
         }
 
-        void Shader::compile (const std::string source_path) {
+        std::string Shader::read_source (const std::string source_path) {
 
-            // Deletes shader if it is already compiled.
-            if (this->id.has_value()) { 
+            std::ifstream stream(source_path);
+            if (!stream.is_open()) {
 
-                this->destroy();
+                throw std::runtime_error(std::string("Failed to open file \"") + source_path + "\"!");
 
             }
+            std::string source_code((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+            stream.close();
 
-            this->id = glCreateShader(this->get_type());
+            return source_code;
+
+        }
+
+        void Shader::compile (const std::string source_path) {
 
             // Reads source code of the shader from the file.
-            std::ifstream stream(source_path);
-            if (!stream.is_open()) {
+            this->compile_source(Shader::read_source(source_path), source_path);
 
-                throw std::runtime_error(std::string("Failed to open file \"") + source_path + "\"!");
+        }
+
+        void Shader::compile_source (const std::string& source_code, const std::string& name) {
+
+            // Deletes shader if it is already compiled.
+            if (this->id.has_value()) { 
+
+                this->destroy();
 
             }
-            std::string source_code((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
-            stream.close();
+
+            this->id = glCreateShader(this->get_type());
 
             // Place the source code in the shader object and compile.
             const char* source_code_pointer = source_code.data();
@@ -61,7 +73,7 @@ namespace triangulation {
                 // std::vector<char> log_message(log_message_length);
                 log_message.resize(log_message_length);
                 glGetShaderInfoLog(this->get_id(), log_message_length, nullptr, log_message.data());
-                std::cout << "GLSL compiler (" << source_path << "): " << log_message.data() << std::endl;
+                std::cout << "GLSL compiler (" << name << "): " << log_message.data() << std::endl;
 
             }
 
@@ -71,7 +83,7 @@ namespace triangulation {
             if (!compilation_status) {
 
                 this->destroy();
-                throw std::runtime_error(std::string("GLSL compiler (" + source_path + "): Failed to compile shader!"));
+                throw std::runtime_error(std::string("GLSL compiler (" + name + "): Failed to compile shader!"));
 
             }
 
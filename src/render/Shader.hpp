@@ -22,8 +22,13 @@ namespace triangulation {
                 GLuint get_id () const;
                 GLenum get_type () const;
 
+                // Reads the source code of a shader from a file.
+                static std::string read_source (const std::string source_path);
+
                 // Compiles the shader from a file.
                 void compile (const std::string source_path);
+                // Compiles the shader from source code; name is only used in log messages.
+                void compile_source (const std::string& source_code, const std::string& name);
                 // Deletes the shader.
                 void destroy ();
 
@@ -0,0 +1,118 @@
+#include "render/ThumbnailRenderer.hpp"
+#include "render/utils.hpp"
+#include "scene/Camera.hpp"
+#include <algorithm>
+#include <glm/glm.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+namespace triangulation {
+    namespace render {
+
+        ThumbnailRenderer::ThumbnailRenderer () : frag_color_uniform(Program::invalid_uniform), next_slot(0) {}
+
+        ThumbnailRenderer::~ThumbnailRenderer () {
+
+            try {
+
+                this->flush();
+
+            } catch (...) {}
+
+        }
+
+        void ThumbnailRenderer::create (std::size_t width, std::size_t height, std::string const& shader_dir, std::string const& cache_dir) {
+
+            this->context.create(3, 3);
+
+            this->program.build({
+                {GL_VERTEX_SHADER, shader_dir + "/main.vert"},
+                {GL_FRAGMENT_SHADER, shader_dir + "/main.frag"}
+            }, cache_dir);
+            this->program.use();
+
+            this->frag_color_uniform = this->program.get_uniform("frag_color");
+            this->program.set_uniform(this->program.get_uniform("model_mat"), glm::mat4(1.0f));
+            this->program.set_uniform(this->program.get_uniform("use_group_colors"), GL_FALSE);
+            this->camera_buffer.create(2*sizeof(glm::mat4), 0);
+            this->program.bind_uniform_block("Camera", 0);
+
+            this->framebuffer.create(width, height);
+            this->geometry.create(glGetAttribLocation(this->program.get_id(), "pos"));
+
+            this->pending_paths.assign(Framebuffer::readback_slots, std::string());
+            this->next_slot = 0;
+
+        }
+
+        void ThumbnailRenderer::render (std::vector<glm::vec2> const& points, std::vector<std::uint32_t> const& indices, std::string const& path) {
+
+            glm::vec2 min_corner(0.0f), max_corner(1.0f), center, half_size;
+            float aspect = static_cast<float>(this->framebuffer.get_width())/this->framebuffer.get_height();
+
+            // Framing the points with a 5% margin, keeping the aspect ratio of the image.
+            if (!points.empty()) {
+
+                min_corner = max_corner = points[0];
+                for (auto const& point : points) {
+
+                    min_corner = glm::min(min_corner, point);
+                    max_corner = glm::max(max_corner, point);
+
+                }
+
+            }
+            center = (min_corner + max_corner)/2.0f;
+            half_size = glm::max((max_corner - min_corner)*0.55f, glm::vec2(1e-6f));
+            if (half_size.x/half_size.y < aspect) half_size.x = half_size.y*aspect;
+            else half_size.y = half_size.x/aspect;
+
+            scene::Camera camera(glm::vec3(0.0f, 0.0f, 1.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f), scene::ORTHOGRAPHIC, 0.01f, 100.0f, center.y - half_size.y, center.y + half_size.y, center.x - half_size.x, center.x + half_size.x);
+            this->camera_buffer.update(0, sizeof(glm::mat4), glm::value_ptr(camera.get_view_matrix()));
+            this->camera_buffer.update(sizeof(glm::mat4), sizeof(glm::mat4), glm::value_ptr(camera.get_projection_matrix()));
+
+            // Every image has new geometry.
+            this->geometry.invalidate();
+            this->geometry.sync_vertices(points);
+            this->geometry.sync_indices(indices);
+
+            this->framebuffer.bind();
+            glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+            glClear(GL_COLOR_BUFFER_BIT);
+
+            glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+            this->program.set_uniform(this->frag_color_uniform, glm::vec4(1.0f));
+            this->geometry.draw_elements(GL_TRIANGLES);
+            glPointSize(3);
+            this->geometry.draw_arrays(GL_POINTS);
+
+            // Writing the image rendered previously in this slot before reusing it.
+            this->write_slot(this->next_slot);
+            this->framebuffer.begin_readback(this->next_slot);
+            this->pending_paths[this->next_slot] = path;
+            this->next_slot = (this->next_slot + 1) % Framebuffer::readback_slots;
+
+        }
+
+        void ThumbnailRenderer::write_slot (std::size_t slot) {
+
+            if (this->pending_paths[slot].empty()) return;
+
+            std::string path = this->pending_paths[slot];
+            this->pending_paths[slot].clear();
+            write_image(path, this->framebuffer.get_width(), this->framebuffer.get_height(), this->framebuffer.finish_readback(slot));
+
+        }
+
+        void ThumbnailRenderer::flush () {
+
+            // Oldest slot first, so images are written in the order they were rendered.
+            for (std::size_t i = 0; i < this->pending_paths.size(); ++i) {
+
+                this->write_slot((this->next_slot + i) % this->pending_paths.size());
+
+            }
+
+        }
+
+    }
+}
@@ -0,0 +1,59 @@
+#ifndef TRIANGULATION_RENDER_THUMBNAILRENDERER_HPP_
+#define TRIANGULATION_RENDER_THUMBNAILRENDERER_HPP_
+
+#include <GL/glew.h>
+#include <glm/vec2.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "render/OffscreenContext.hpp"
+#include "render/Program.hpp"
+#include "render/Framebuffer.hpp"
+#include "render/GeometryBuffer.hpp"
+#include "render/UniformBuffer.hpp"
+
+namespace triangulation {
+    namespace render {
+
+        // Renders triangulations to image files without a window, using an OffscreenContext and the viewer shaders.
+        // The readback of each image overlaps with rendering the next one: an image is written to disk
+        // when its readback slot is reused, or on flush().
+        class ThumbnailRenderer {
+
+            private:
+
+                // Declared first so it is destroyed after every other OpenGL object.
+                OffscreenContext context;
+                Program program;
+                Framebuffer framebuffer;
+                GeometryBuffer geometry;
+                UniformBuffer camera_buffer;
+                Program::UniformHandle frag_color_uniform;
+
+                // Output path of the image in flight in each readback slot (empty if none).
+                std::vector<std::string> pending_paths;
+                std::size_t next_slot;
+
+                void write_slot (std::size_t slot);
+
+            public:
+
+                ThumbnailRenderer ();
+                ~ThumbnailRenderer ();
+
+                // Creates the context, the framebuffer and the program (shaders read from shader_dir, binaries cached in cache_dir).
+                void create (std::size_t width, std::size_t height, std::string const& shader_dir, std::string const& cache_dir);
+
+                // Renders the points and the triangles (three indices into points per triangle), framed to fit the points.
+                // The image is written to path as PNG, or PPM if path ends with ".ppm".
+                void render (std::vector<glm::vec2> const& points, std::vector<std::uint32_t> const& indices, std::string const& path);
+
+                // Writes every image still in flight.
+                void flush ();
+
+        };
+
+    }
+}
+
+#endif
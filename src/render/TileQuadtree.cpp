@@ -0,0 +1,263 @@
+#include "render/TileQuadtree.hpp"
+#include <cmath>
+#include <limits>
+#include <glm/glm.hpp>
+
+namespace triangulation {
+    namespace render {
+
+        TileQuadtree::TileQuadtree () {}
+
+        TileQuadtree::~TileQuadtree () {
+
+            this->destroy();
+
+        }
+
+        bool TileQuadtree::is_created () const {
+
+            return this->triangles_vao.has_value();
+
+        }
+
+        std::int32_t TileQuadtree::build_node (std::vector<glm::vec2> const& points, std::vector<std::uint32_t> const& indices, std::vector<std::uint32_t>& triangles, glm::vec2 min_corner, glm::vec2 max_corner, unsigned int depth, std::vector<std::uint32_t>& tile_indices, std::vector<std::uint32_t>& lod_indices) {
+
+            const std::uint32_t empty_cell = std::numeric_limits<std::uint32_t>::max();
+
+            Node node;
+            std::vector<std::uint32_t> cells(lod_grid_size*lod_grid_size, empty_cell);
+            std::int32_t node_index = this->nodes.size();
+            glm::vec2 extent;
+
+            node.triangle_count = triangles.size();
+            node.first_index = node.index_count = 0;
+            for (auto& child : node.children) {
+
+                child = -1;
+
+            }
+
+            // Tight bounding box, used for culling.
+            node.min_corner = glm::vec2(INFINITY);
+            node.max_corner = glm::vec2(-INFINITY);
+            for (auto const& triangle : triangles) {
+
+                for (std::size_t k = 0; k < 3; ++k) {
+
+                    node.min_corner = glm::min(node.min_corner, points[indices[3*triangle + k]]);
+                    node.max_corner = glm::max(node.max_corner, points[indices[3*triangle + k]]);
+
+                }
+
+            }
+
+            // Keeping the first vertex that falls in each cell of a grid over the node as its representative points.
+            extent = glm::max(node.max_corner - node.min_corner, glm::vec2(std::numeric_limits<float>::min()));
+            for (auto const& triangle : triangles) {
+
+                for (std::size_t k = 0; k < 3; ++k) {
+
+                    std::uint32_t vertex = indices[3*triangle + k];
+                    glm::vec2 cell = glm::clamp((points[vertex] - node.min_corner)/extent*static_cast<float>(lod_grid_size), glm::vec2(0.0f), glm::vec2(lod_grid_size - 1));
+                    std::uint32_t& cell_vertex = cells[static_cast<std::size_t>(cell.y)*lod_grid_size + static_cast<std::size_t>(cell.x)];
+
+                    if (cell_vertex == empty_cell) cell_vertex = vertex;
+
+                }
+
+            }
+
+            node.first_point = lod_indices.size();
+            for (auto const& vertex : cells) {
+
+                if (vertex != empty_cell) lod_indices.push_back(vertex);
+
+            }
+            node.point_count = lod_indices.size() - node.first_point;
+
+            this->nodes.push_back(node);
+
+            if (triangles.size() <= max_tile_triangles || depth >= max_depth) {
+
+                this->nodes[node_index].first_index = tile_indices.size();
+                for (auto const& triangle : triangles) {
+
+                    tile_indices.insert(tile_indices.end(), indices.begin() + 3*triangle, indices.begin() + 3*triangle + 3);
+
+                }
+                this->nodes[node_index].index_count = tile_indices.size() - this->nodes[node_index].first_index;
+
+            } else {
+
+                // Splitting the triangles by the quadrant of their centroid.
+                glm::vec2 center = (min_corner + max_corner)/2.0f;
+                std::vector<std::uint32_t> quadrants[4];
+
+                for (auto const& triangle : triangles) {
+
+                    glm::vec2 centroid = (points[indices[3*triangle]] + points[indices[3*triangle + 1]] + points[indices[3*triangle + 2]])/3.0f;
+                    quadrants[(centroid.x >= center.x ? 1 : 0) + (centroid.y >= center.y ? 2 : 0)].push_back(triangle);
+
+                }
+
+                // The triangles are now in the quadrants.
+                triangles.clear();
+                triangles.shrink_to_fit();
+
+                for (std::size_t q = 0; q < 4; ++q) {
+
+                    if (quadrants[q].empty()) continue;
+
+                    glm::vec2
+                        quadrant_min((q & 1) ? center.x : min_corner.x, (q & 2) ? center.y : min_corner.y),
+                        quadrant_max((q & 1) ? max_corner.x : center.x, (q & 2) ? max_corner.y : center.y);
+
+                    std::int32_t child = this->build_node(points, indices, quadrants[q], quadrant_min, quadrant_max, depth + 1, tile_indices, lod_indices);
+                    this->nodes[node_index].children[q] = child;
+
+                }
+
+            }
+
+            return node_index;
+
+        }
+
+        void TileQuadtree::create (std::vector<glm::vec2> const& points, std::vector<std::uint32_t> const& indices, GLuint vertex_buffer, GLuint attrib_location) {
+
+            std::vector<std::uint32_t> triangles(indices.size()/3), tile_indices, lod_indices;
+            glm::vec2 min_corner(INFINITY), max_corner(-INFINITY);
+            GLuint ids[2];
+
+            this->destroy();
+
+            if (triangles.empty()) return;
+
+            for (std::uint32_t i = 0; i < triangles.size(); ++i) {
+
+                triangles[i] = i;
+
+            }
+            for (auto const& index : indices) {
+
+                min_corner = glm::min(min_corner, points[index]);
+                max_corner = glm::max(max_corner, points[index]);
+
+            }
+
+            tile_indices.reserve(indices.size());
+            this->build_node(points, indices, triangles, min_corner, max_corner, 0, tile_indices, lod_indices);
+
+            glGenVertexArrays(2, ids);
+            this->triangles_vao = ids[0];
+            this->points_vao = ids[1];
+            glGenBuffers(2, ids);
+            this->triangles_ebo = ids[0];
+            this->points_ebo = ids[1];
+
+            // Both vertex arrays read the positions from the existing vertex buffer.
+            auto setup_vertex_array = [vertex_buffer, attrib_location] (GLuint vao, GLuint ebo, std::vector<std::uint32_t> const& data) {
+
+                glBindVertexArray(vao);
+                glBindBuffer(GL_ARRAY_BUFFER, vertex_buffer);
+                glEnableVertexAttribArray(attrib_location);
+                glVertexAttribPointer(attrib_location, 2, GL_FLOAT, GL_FALSE, 0, (GLvoid*)0);
+                glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
+                glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(std::uint32_t)*data.size(), data.data(), GL_STATIC_DRAW);
+
+            };
+
+            setup_vertex_array(this->triangles_vao.value(), this->triangles_ebo.value(), tile_indices);
+            setup_vertex_array(this->points_vao.value(), this->points_ebo.value(), lod_indices);
+            glBindVertexArray(0);
+
+        }
+
+        void TileQuadtree::select_nodes (std::int32_t node_index, glm::mat4 const& view_projection, glm::vec2 viewport_size, float min_pixels_per_triangle) {
+
+            Node const& node = this->nodes[node_index];
+            glm::vec2 ndc_min(INFINITY), ndc_max(-INFINITY), pixel_size;
+
+            // Projecting the bounding box to normalized device coordinates.
+            for (std::size_t corner = 0; corner < 4; ++corner) {
+
+                glm::vec4 clip = view_projection * glm::vec4((corner & 1) ? node.max_corner.x : node.min_corner.x, (corner & 2) ? node.max_corner.y : node.min_corner.y, 0.0f, 1.0f);
+                glm::vec2 ndc = glm::vec2(clip.x, clip.y)/clip.w;
+
+                ndc_min = glm::min(ndc_min, ndc);
+                ndc_max = glm::max(ndc_max, ndc);
+
+            }
+
+            // Culling nodes outside the view volume.
+            if (ndc_max.x < -1.0f || ndc_min.x > 1.0f || ndc_max.y < -1.0f || ndc_min.y > 1.0f) return;
+
+            // Drawing nodes too small on screen for their triangles as points.
+            pixel_size = (ndc_max - ndc_min)*viewport_size/2.0f;
+            if (node.point_count > 0 && pixel_size.x*pixel_size.y < min_pixels_per_triangle*node.triangle_count) {
+
+                this->point_counts.push_back(node.point_count);
+                this->point_offsets.push_back((const void*)(sizeof(std::uint32_t)*node.first_point));
+                return;
+
+            }
+
+            if (node.index_count > 0) {
+
+                this->triangle_counts.push_back(node.index_count);
+                this->triangle_offsets.push_back((const void*)(sizeof(std::uint32_t)*node.first_index));
+
+            }
+
+            for (auto const& child : node.children) {
+
+                if (child != -1) this->select_nodes(child, view_projection, viewport_size, min_pixels_per_triangle);
+
+            }
+
+        }
+
+        void TileQuadtree::draw (glm::mat4 const& view_projection, glm::vec2 viewport_size, float min_pixels_per_triangle) {
+
+            if (this->nodes.empty() || !this->is_created()) return;
+
+            this->triangle_counts.clear();
+            this->triangle_offsets.clear();
+            this->point_counts.clear();
+            this->point_offsets.clear();
+
+            this->select_nodes(0, view_projection, viewport_size, min_pixels_per_triangle);
+
+            if (!this->triangle_counts.empty()) {
+
+                glBindVertexArray(this->triangles_vao.value());
+                glMultiDrawElements(GL_TRIANGLES, this->triangle_counts.data(), GL_UNSIGNED_INT, this->triangle_offsets.data(), this->triangle_counts.size());
+
+            }
+
+            if (!this->point_counts.empty()) {
+
+                glBindVertexArray(this->points_vao.value());
+                glMultiDrawElements(GL_POINTS, this->point_counts.data(), GL_UNSIGNED_INT, this->point_offsets.data(), this->point_counts.size());
+
+            }
+
+        }
+
+        void TileQuadtree::destroy () {
+
+            if (this->triangles_ebo.has_value()) glDeleteBuffers(1, &this->triangles_ebo.value());
+            if (this->points_ebo.has_value()) glDeleteBuffers(1, &this->points_ebo.value());
+            if (this->triangles_vao.has_value()) glDeleteVertexArrays(1, &this->triangles_vao.value());
+            if (this->points_vao.has_value()) glDeleteVertexArrays(1, &this->points_vao.value());
+
+            this->triangles_vao.reset();
+            this->points_vao.reset();
+            this->triangles_ebo.reset();
+            this->points_ebo.reset();
+            this->nodes.clear();
+
+        }
+
+    }
+}
@@ -0,0 +1,75 @@
+#ifndef TRIANGULATION_RENDER_TILEQUADTREE_HPP_
+#define TRIANGULATION_RENDER_TILEQUADTREE_HPP_
+
+#include <GL/glew.h>
+#include <glm/vec2.hpp>
+#include <glm/mat4x4.hpp>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace triangulation {
+    namespace render {
+
+        // Splits a triangulation into a quadtree of tiles kept on the GPU, so each frame only draws what the camera sees.
+        // Leaves own a contiguous range of the triangle index buffer. Every node also owns a small set of representative
+        // points, drawn instead of its triangles when the node covers too few pixels for them to be visible.
+        class TileQuadtree {
+
+            private:
+
+                struct Node {
+
+                    // Bounding box of the vertices of the triangles in the node.
+                    glm::vec2 min_corner, max_corner;
+                    std::size_t triangle_count;
+                    // Children indices (-1 if the node is a leaf).
+                    std::int32_t children[4];
+                    // Ranges in the triangle (leaves only) and point index buffers.
+                    std::size_t first_index, index_count, first_point, point_count;
+
+                };
+
+                std::vector<Node> nodes;
+                std::optional<GLuint> triangles_vao, points_vao, triangles_ebo, points_ebo;
+
+                // Arguments of the multi-draw calls, rebuilt every frame.
+                std::vector<GLsizei> triangle_counts, point_counts;
+                std::vector<const void*> triangle_offsets, point_offsets;
+
+                std::int32_t build_node (std::vector<glm::vec2> const& points, std::vector<std::uint32_t> const& indices, std::vector<std::uint32_t>& triangles, glm::vec2 min_corner, glm::vec2 max_corner, unsigned int depth, std::vector<std::uint32_t>& tile_indices, std::vector<std::uint32_t>& lod_indices);
+
+                void select_nodes (std::int32_t node, glm::mat4 const& view_projection, glm::vec2 viewport_size, float min_pixels_per_triangle);
+
+            public:
+
+                // Leaves hold at most this many triangles (unless the maximum depth is reached).
+                static constexpr std::size_t max_tile_triangles = 4096;
+                static constexpr unsigned int max_depth = 16;
+                // The representative points of a node are chosen on a grid of lod_grid_size x lod_grid_size cells.
+                static constexpr unsigned int lod_grid_size = 16;
+
+                TileQuadtree ();
+                ~TileQuadtree ();
+
+                TileQuadtree (TileQuadtree const&) = delete;
+                TileQuadtree& operator = (TileQuadtree const&) = delete;
+
+                bool is_created () const;
+
+                // Builds the tiles of a triangulation (three indices into points per triangle).
+                // The points must already be in vertex_buffer, bound to the vec2 attribute at attrib_location.
+                void create (std::vector<glm::vec2> const& points, std::vector<std::uint32_t> const& indices, GLuint vertex_buffer, GLuint attrib_location);
+
+                // Draws the tiles intersecting the view volume. Nodes whose area in pixels is smaller than
+                // min_pixels_per_triangle times their triangle count are drawn as points.
+                void draw (glm::mat4 const& view_projection, glm::vec2 viewport_size, float min_pixels_per_triangle = 4.0f);
+
+                void destroy ();
+
+        };
+
+    }
+}
+
+#endif
@@ -0,0 +1,62 @@
+#include "render/UniformBuffer.hpp"
+#include <stdexcept>
+
+namespace triangulation {
+    namespace render {
+
+        UniformBuffer::UniformBuffer () : size(0) {}
+
+        UniformBuffer::~UniformBuffer () {
+
+            this->destroy();
+
+        }
+
+        GLuint UniformBuffer::get_id () const {
+
+            return this->id.value_or(0);
+
+        }
+
+        std::size_t UniformBuffer::get_size () const {
+
+            return this->size;
+
+        }
+
+        void UniformBuffer::create (std::size_t _size, GLuint binding, GLenum usage) {
+
+            GLuint buffer;
+
+            this->destroy();
+
+            glGenBuffers(1, &buffer);
+            this->id = buffer;
+            this->size = _size;
+
+            glBindBuffer(GL_UNIFORM_BUFFER, buffer);
+            glBufferData(GL_UNIFORM_BUFFER, this->size, nullptr, usage);
+            glBindBufferBase(GL_UNIFORM_BUFFER, binding, buffer);
+
+        }
+
+        void UniformBuffer::update (std::size_t offset, std::size_t size, const void* data) const {
+
+            if (!this->id.has_value()) throw std::runtime_error("Error: Failed to update a uniform buffer that was not created!");
+            if (offset + size > this->size) throw std::out_of_range("Error: Uniform buffer update out of range!");
+
+            glBindBuffer(GL_UNIFORM_BUFFER, this->id.value());
+            glBufferSubData(GL_UNIFORM_BUFFER, offset, size, data);
+
+        }
+
+        void UniformBuffer::destroy () {
+
+            if (this->id.has_value()) glDeleteBuffers(1, &this->id.value());
+            this->id.reset();
+            this->size = 0;
+
+        }
+
+    }
+}
@@ -0,0 +1,42 @@
+#ifndef TRIANGULATION_RENDER_UNIFORMBUFFER_HPP_
+#define TRIANGULATION_RENDER_UNIFORMBUFFER_HPP_
+
+#include <GL/glew.h>
+#include <optional>
+
+namespace triangulation {
+    namespace render {
+
+        // Buffer backing a uniform block (std140 layout), shared by every program bound to the same binding point.
+        class UniformBuffer {
+
+            private:
+
+                std::optional<GLuint> id;
+                std::size_t size;
+
+            public:
+
+                UniformBuffer ();
+                ~UniformBuffer ();
+
+                UniformBuffer (UniformBuffer const&) = delete;
+                UniformBuffer& operator = (UniformBuffer const&) = delete;
+
+                GLuint get_id () const;
+                std::size_t get_size () const;
+
+                // Allocates the buffer and attaches it to a uniform buffer binding point.
+                void create (std::size_t _size, GLuint binding, GLenum usage = GL_DYNAMIC_DRAW);
+
+                // Writes size bytes at offset.
+                void update (std::size_t offset, std::size_t size, const void* data) const;
+
+                void destroy ();
+
+        };
+
+    }
+}
+
+#endif
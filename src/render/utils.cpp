@@ -3,54 +3,147 @@
 #include <iostream>
 #include <stdexcept>
 #include <fstream>
-#include <sstream>
+#include <algorithm>
 
 namespace triangulation {
     namespace render {
 
-        std::vector<std::vector<glm::vec2>> parse_obj (const std::string& file_name) {
+        void write_ppm (const std::string& file_name, std::size_t width, std::size_t height, std::vector<std::uint8_t> const& pixels) {
 
-            std::ifstream file(file_name);
+            std::ofstream file(file_name, std::ios::binary);
             if (!file) {
 
                 throw std::invalid_argument("Failed to open file: " + file_name + "\n");
 
             }
 
-            std::vector<std::vector<glm::vec2>> groups;
-            int current_group = -1;
-            std::string line;
+            file << "P6\n" << width << " " << height << "\n255\n";
+            for (std::size_t row = height; row-- > 0;) {
 
-            while (std::getline(file, line)) {
+                for (std::size_t column = 0; column < width; ++column) {
 
-                std::istringstream ss(line);
-                std::string prefix;
-                ss >> prefix;
+                    file.write(reinterpret_cast<const char*>(&pixels[4*(row*width + column)]), 3);
 
-                if (prefix == "v") {
+                }
+
+            }
+
+        }
+
+        void write_png (const std::string& file_name, std::size_t width, std::size_t height, std::vector<std::uint8_t> const& pixels) {
+
+            std::ofstream file(file_name, std::ios::binary);
+            if (!file) {
+
+                throw std::invalid_argument("Failed to open file: " + file_name + "\n");
+
+            }
+
+            std::uint32_t crc_table[256];
+            for (std::uint32_t n = 0; n < 256; ++n) {
+
+                std::uint32_t c = n;
+                for (int k = 0; k < 8; ++k) {
+
+                    c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+
+                }
+                crc_table[n] = c;
+
+            }
+
+            auto append_u32 = [] (std::vector<std::uint8_t>& data, std::uint32_t value) {
+
+                for (int shift = 24; shift >= 0; shift -= 8) {
+
+                    data.push_back(static_cast<std::uint8_t>(value >> shift));
+
+                }
+
+            };
+
+            auto write_chunk = [&file, &crc_table, &append_u32] (const char* type, std::vector<std::uint8_t> const& data) {
 
-                    if (current_group == -1) {
+                std::vector<std::uint8_t> chunk;
+                std::uint32_t crc = 0xFFFFFFFFu;
 
-                        groups.push_back(std::vector<glm::vec2>());
-                        ++current_group;
+                append_u32(chunk, data.size());
+                chunk.insert(chunk.end(), type, type + 4);
+                chunk.insert(chunk.end(), data.begin(), data.end());
+                for (std::size_t i = 4; i < chunk.size(); ++i) {
+
+                    crc = crc_table[(crc ^ chunk[i]) & 0xFF] ^ (crc >> 8);
+
+                }
+                append_u32(chunk, crc ^ 0xFFFFFFFFu);
 
-                    }
+                file.write(reinterpret_cast<const char*>(chunk.data()), chunk.size());
 
-                    float x, y;
-                    ss >> x >> y;
+            };
 
-                    groups[current_group].emplace_back(x, y);
+            // Scanlines from the top row, each one preceded by filter type 0 (none).
+            std::vector<std::uint8_t> raw;
+            raw.reserve((3*width + 1)*height);
+            for (std::size_t row = height; row-- > 0;) {
 
-                } else if (prefix == "g") {
+                raw.push_back(0);
+                for (std::size_t column = 0; column < width; ++column) {
 
-                    groups.push_back(std::vector<glm::vec2>());
-                    ++current_group;
+                    raw.insert(raw.end(), &pixels[4*(row*width + column)], &pixels[4*(row*width + column)] + 3);
 
                 }
 
             }
 
-            return groups;
+            // zlib stream made of stored blocks of at most 65535 bytes.
+            std::vector<std::uint8_t> compressed = {0x78, 0x01};
+            std::uint32_t adler_a = 1, adler_b = 0;
+            std::size_t offset = 0;
+            do {
+
+                std::size_t length = std::min<std::size_t>(65535, raw.size() - offset);
+                compressed.push_back((offset + length >= raw.size()) ? 1 : 0);
+                compressed.push_back(length & 0xFF);
+                compressed.push_back(length >> 8);
+                compressed.push_back(~length & 0xFF);
+                compressed.push_back((~length >> 8) & 0xFF);
+                compressed.insert(compressed.end(), raw.begin() + offset, raw.begin() + offset + length);
+                offset += length;
+
+            } while (offset < raw.size());
+            for (auto const& byte : raw) {
+
+                adler_a = (adler_a + byte) % 65521;
+                adler_b = (adler_b + adler_a) % 65521;
+
+            }
+            append_u32(compressed, (adler_b << 16) | adler_a);
+
+            std::vector<std::uint8_t> header;
+            append_u32(header, width);
+            append_u32(header, height);
+            // Bit depth 8, colour type 2 (RGB), default compression, filter and interlace methods.
+            header.insert(header.end(), {8, 2, 0, 0, 0});
+
+            const std::uint8_t signature[] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+            file.write(reinterpret_cast<const char*>(signature), sizeof(signature));
+            write_chunk("IHDR", header);
+            write_chunk("IDAT", compressed);
+            write_chunk("IEND", {});
+
+        }
+
+        void write_image (const std::string& file_name, std::size_t width, std::size_t height, std::vector<std::uint8_t> const& pixels) {
+
+            if (file_name.size() >= 4 && file_name.compare(file_name.size() - 4, 4, ".ppm") == 0) {
+
+                write_ppm(file_name, width, height, pixels);
+
+            } else {
+
+                write_png(file_name, width, height, pixels);
+
+            }
 
         }
 
@@ -5,6 +5,7 @@
 #define GLFW_INCLUDE_NONE
 #include <GLFW/glfw3.h>
 #include <glm/vec2.hpp>
+#include <cstdint>
 #include <string>
 #include <vector>
 
@@ -15,7 +16,13 @@
 namespace triangulation {
     namespace render {
 
-        std::vector<std::vector<glm::vec2>> parse_obj (const std::string& file_name);
+        // Image output. Pixels are RGBA with the bottom row first, as returned by glReadPixels.
+
+        void write_ppm (const std::string& file_name, std::size_t width, std::size_t height, std::vector<std::uint8_t> const& pixels);
+        // Writes an RGB PNG with uncompressed (stored) deflate blocks, so no compression library is needed.
+        void write_png (const std::string& file_name, std::size_t width, std::size_t height, std::vector<std::uint8_t> const& pixels);
+        // Chooses the format from the file extension (".ppm", otherwise PNG).
+        void write_image (const std::string& file_name, std::size_t width, std::size_t height, std::vector<std::uint8_t> const& pixels);
 
         // OpenGL Debug
 
@@ -28,6 +35,7 @@ namespace triangulation {
         void glfw_error_callback (int error, const char* description);
         void glfw_key_callback (GLFWwindow* window, int key, int scancode, int action, int mods);
         void glfw_framebuffer_size_callback (GLFWwindow* window, int width, int height);
+        void glfw_scroll_callback (GLFWwindow* window, double x_offset, double y_offset);
 
     }
 }
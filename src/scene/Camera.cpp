@@ -144,6 +144,26 @@ namespace triangulation {
 
         }
 
+        void Camera::pan(glm::vec2 offset) {
+
+            this->left += offset.x;
+            this->right += offset.x;
+            this->bottom += offset.y;
+            this->top += offset.y;
+            this->need_to_update_projection_matrix = true;
+
+        }
+
+        void Camera::zoom(float factor, glm::vec2 center) {
+
+            this->left = center.x + (this->left - center.x) * factor;
+            this->right = center.x + (this->right - center.x) * factor;
+            this->bottom = center.y + (this->bottom - center.y) * factor;
+            this->top = center.y + (this->top - center.y) * factor;
+            this->need_to_update_projection_matrix = true;
+
+        }
+
         void Camera::update_view_matrix() {
 
             // Remember: GLSL/GLM matrices are stored and initialized in column-major order!
@@ -1,6 +1,7 @@
 #ifndef TRIANGULATION_SCENE_CAMERA_HPP
 #define TRIANGULATION_SCENE_CAMERA_HPP
 
+#include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
 #include <glm/mat4x4.hpp>
 
@@ -69,6 +70,12 @@ class Camera {
 
         glm::mat4 const& get_projection_matrix();
 
+        // Moves the left/right/bottom/top frame by offset (in view space units).
+        void pan(glm::vec2 offset);
+
+        // Scales the left/right/bottom/top frame around center (in view space); factor < 1 zooms in.
+        void zoom(float factor, glm::vec2 center);
+
 };
 
 }
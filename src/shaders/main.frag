@@ -1,11 +1,27 @@
 #version 330 core
 
 uniform vec4 frag_color;
+uniform bool use_group_colors;
+uniform bool use_height_colors;
+
+flat in vec4 group_color;
+in float height;
 
 layout(location = 0) out vec4 color;
 
+// Hue ramp from blue (lowest) through green to red (highest).
+vec3 get_height_color(float h) {
+
+    float hue = (1.0 - clamp(h, 0.0, 1.0)) * 2.0 / 3.0;
+    return clamp(vec3(abs(hue*6.0 - 3.0) - 1.0, 2.0 - abs(hue*6.0 - 2.0), 2.0 - abs(hue*6.0 - 4.0)), 0.0, 1.0);
+
+}
+
 void main() {
 
-    color = frag_color;
+    // The height colour is tinted by frag_color so dimmed draws stay dimmed.
+    if (use_group_colors) color = group_color;
+    else if (use_height_colors) color = vec4(get_height_color(height), 1.0) * frag_color;
+    else color = frag_color;
 
-}
\ No newline at end of file
+}
@@ -1,13 +1,39 @@
 #version 330 core
 
 layout(location=0) in vec2 pos;
+// Index of the group of the vertex (only used when use_group_colors is set).
+layout(location=1) in uint group;
 
 uniform mat4 model_mat;
-uniform mat4 view_mat;
-uniform mat4 projection_mat;
+
+// Shared by every program through uniform buffer binding 0.
+layout(std140) uniform Camera {
+
+    mat4 view_mat;
+    mat4 projection_mat;
+
+};
+
+uniform bool use_group_colors;
+uniform samplerBuffer group_colors;
+
+// Height of each vertex, fetched by vertex index (only used when use_height_colors is set), and the heights mapped to the
+// bottom and top of the colour ramp.
+uniform bool use_height_colors;
+uniform samplerBuffer heights;
+uniform vec2 height_range;
+
+flat out vec4 group_color;
+out float height;
 
 void main() {
 
     gl_Position = projection_mat * view_mat * model_mat * vec4(pos, 0.0, 1.0);
 
-}
\ No newline at end of file
+    if (use_group_colors) group_color = texelFetch(group_colors, int(group));
+    else group_color = vec4(1.0);
+
+    if (use_height_colors) height = (texelFetch(heights, gl_VertexID).r - height_range.x) / max(height_range.y - height_range.x, 1e-20);
+    else height = 0.0;
+
+}
@@ -0,0 +1,224 @@
+#include "triangulation.h"
+#include "AdvancingFront.hpp"
+#include "QuickHull.hpp"
+#include "PointLocation.hpp"
+#include "ObjFile.hpp"
+#include <algorithm>
+#include <new>
+#include <stdexcept>
+#include <string>
+
+namespace triangulation {
+
+    namespace {
+
+        thread_local std::string error_message;
+
+        // Runs the function, turning exceptions into status codes since none may cross the C interface.
+        template <typename Function>
+        triangulation_status guard (Function function) {
+
+            try {
+
+                error_message.clear();
+                return function();
+
+            } catch (std::bad_alloc const&) {
+
+                error_message = "Error: Out of memory!";
+                return TRIANGULATION_OUT_OF_MEMORY;
+
+            } catch (std::invalid_argument const& exception) {
+
+                error_message = exception.what();
+                return TRIANGULATION_INVALID_ARGUMENT;
+
+            } catch (std::out_of_range const& exception) {
+
+                error_message = exception.what();
+                return TRIANGULATION_INVALID_ARGUMENT;
+
+            } catch (std::exception const& exception) {
+
+                error_message = exception.what();
+                return TRIANGULATION_INTERNAL_ERROR;
+
+            } catch (...) {
+
+                error_message = "Error: Unknown exception!";
+                return TRIANGULATION_INTERNAL_ERROR;
+
+            }
+
+        }
+
+        std::vector<glm::vec2> to_points (float const* coordinates, std::size_t point_count) {
+
+            if (coordinates == nullptr && point_count > 0) throw std::invalid_argument("Error: Null points!");
+
+            std::vector<glm::vec2> points(point_count);
+            for (std::size_t i = 0; i < point_count; i++) {
+
+                points[i] = glm::vec2(coordinates[2*i], coordinates[2*i + 1]);
+
+            }
+
+            return points;
+
+        }
+
+        // Copies the values if they fit in the buffer; the count is set either way.
+        template <typename T>
+        triangulation_status copy_out (std::vector<T> const& values, T* buffer, std::size_t capacity, std::size_t* count) {
+
+            if (count == nullptr) throw std::invalid_argument("Error: Null count!");
+
+            *count = values.size();
+            if (values.size() > capacity) {
+
+                error_message = "Error: Output buffer too small!";
+                return TRIANGULATION_BUFFER_TOO_SMALL;
+
+            }
+            if (!values.empty() && buffer == nullptr) throw std::invalid_argument("Error: Null output buffer!");
+
+            std::copy(values.begin(), values.end(), buffer);
+            return TRIANGULATION_OK;
+
+        }
+
+        std::vector<float> to_coordinates (std::vector<glm::vec2> const& points) {
+
+            std::vector<float> coordinates;
+
+            coordinates.reserve(2 * points.size());
+            for (auto const& point : points) {
+
+                coordinates.push_back(point.x);
+                coordinates.push_back(point.y);
+
+            }
+
+            return coordinates;
+
+        }
+
+        triangulation_status copy_out_points (std::vector<glm::vec2> const& points, float* buffer, std::size_t capacity, std::size_t* count) {
+
+            std::size_t coordinate_count = 0;
+            triangulation_status status = copy_out(to_coordinates(points), buffer, (capacity > SIZE_MAX / 2) ? SIZE_MAX : 2 * capacity, &coordinate_count);
+
+            if (count != nullptr) *count = coordinate_count / 2;
+            return status;
+
+        }
+
+    }
+
+}
+
+using namespace triangulation;
+
+extern "C" {
+
+    uint32_t triangulation_get_abi_version (void) {
+
+        return TRIANGULATION_ABI_VERSION;
+
+    }
+
+    const char* triangulation_get_error_message (void) {
+
+        return error_message.c_str();
+
+    }
+
+    triangulation_status triangulation_compute (const float* points, size_t point_count, uint32_t* indices, size_t index_capacity, size_t* index_count) {
+
+        return guard([&] () {
+
+            return copy_out(AdvancingFront::compute_triangulation_indices(to_points(points, point_count)), indices, index_capacity, index_count);
+
+        });
+
+    }
+
+    triangulation_status triangulation_compute_hull (const float* points, size_t point_count, float* hull, size_t hull_capacity, size_t* hull_count) {
+
+        return guard([&] () {
+
+            if (hull_count == nullptr) throw std::invalid_argument("Error: Null count!");
+            return copy_out_points(QuickHull::compute_hull(to_points(points, point_count)), hull, hull_capacity, hull_count);
+
+        });
+
+    }
+
+    triangulation_status triangulation_locate (const float* points, size_t point_count, const uint32_t* indices, size_t index_count, const float* queries, size_t query_count, unsigned int thread_count, uint32_t* triangles) {
+
+        return guard([&] () {
+
+            if ((indices == nullptr && index_count > 0) || (triangles == nullptr && query_count > 0)) throw std::invalid_argument("Error: Null argument!");
+
+            PointLocation location(to_points(points, point_count), std::vector<std::uint32_t>(indices, indices + index_count));
+            std::vector<std::uint32_t> located = location.locate(to_points(queries, query_count), thread_count);
+
+            std::copy(located.begin(), located.end(), triangles);
+            return TRIANGULATION_OK;
+
+        });
+
+    }
+
+    triangulation_status triangulation_read_obj (const char* path, float* points, size_t point_capacity, size_t* point_count) {
+
+        return guard([&] () {
+
+            if (path == nullptr || point_count == nullptr) throw std::invalid_argument("Error: Null argument!");
+
+            std::vector<glm::vec2> all_points;
+            try {
+
+                for (auto const& group : ObjFile::read(path)) {
+
+                    all_points.insert(all_points.end(), group.begin(), group.end());
+
+                }
+
+            } catch (std::invalid_argument const& exception) {
+
+                error_message = exception.what();
+                return TRIANGULATION_IO_ERROR;
+
+            }
+
+            return copy_out_points(all_points, points, point_capacity, point_count);
+
+        });
+
+    }
+
+    triangulation_status triangulation_write_obj (const char* path, const float* points, size_t point_count, const uint32_t* indices, size_t index_count) {
+
+        return guard([&] () {
+
+            if (path == nullptr || (indices == nullptr && index_count > 0)) throw std::invalid_argument("Error: Null argument!");
+
+            try {
+
+                ObjFile::write(path, to_points(points, point_count), std::vector<std::uint32_t>(indices, indices + index_count));
+
+            } catch (std::runtime_error const& exception) {
+
+                error_message = exception.what();
+                return TRIANGULATION_IO_ERROR;
+
+            }
+
+            return TRIANGULATION_OK;
+
+        });
+
+    }
+
+}
@@ -0,0 +1,72 @@
+#ifndef TRIANGULATION_H
+#define TRIANGULATION_H
+
+/* C interface of libtriangulation. Only these functions are exported by the shared library; the ABI version is
+ * increased whenever a signature or the meaning of an argument changes.
+ * Points are interleaved x, y pairs of floats and triangles are triples of 0-based point indices.
+ * Output buffers belong to the caller: when one is too small, TRIANGULATION_BUFFER_TOO_SMALL is returned and
+ * the required count is stored in the count argument. */
+
+#include <stddef.h>
+#include <stdint.h>
+
+/* The library is built with TRIANGULATION_BUILD defined, which exports the functions; programs using the DLL import them.
+ * Programs linking the static library on Windows define TRIANGULATION_STATIC. */
+#if defined(_WIN32) && defined(TRIANGULATION_STATIC)
+#define TRIANGULATION_API
+#elif defined(_WIN32) && defined(TRIANGULATION_BUILD)
+#define TRIANGULATION_API __declspec(dllexport)
+#elif defined(_WIN32)
+#define TRIANGULATION_API __declspec(dllimport)
+#else
+#define TRIANGULATION_API __attribute__((visibility("default")))
+#endif
+
+#define TRIANGULATION_ABI_VERSION 1
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum triangulation_status {
+
+    TRIANGULATION_OK = 0,
+    TRIANGULATION_INVALID_ARGUMENT = 1,
+    TRIANGULATION_BUFFER_TOO_SMALL = 2,
+    TRIANGULATION_IO_ERROR = 3,
+    TRIANGULATION_OUT_OF_MEMORY = 4,
+    TRIANGULATION_INTERNAL_ERROR = 5
+
+} triangulation_status;
+
+/* TRIANGULATION_ABI_VERSION of the library, to check against the header at run time. */
+TRIANGULATION_API uint32_t triangulation_get_abi_version (void);
+
+/* Message of the last error on the calling thread, or an empty string. */
+TRIANGULATION_API const char* triangulation_get_error_message (void);
+
+/* Triangulation (AdvancingFront) of the points, with triangles counterclockwise. It is Delaunay for points in general
+ * position, but not with points on the convex hull edges (grids, ...), which it leaves out.
+ * There are less than 2 * point_count triangles, so 6 * point_count indices always fit. */
+TRIANGULATION_API triangulation_status triangulation_compute (const float* points, size_t point_count, uint32_t* indices, size_t index_capacity, size_t* index_count);
+
+/* Convex hull of the points (QuickHull), clockwise from the leftmost point (the lowest one on ties), without collinear
+ * points. Capacity and count are in points. */
+TRIANGULATION_API triangulation_status triangulation_compute_hull (const float* points, size_t point_count, float* hull, size_t hull_capacity, size_t* hull_count);
+
+/* Triangle containing each query point, as the position of its first index in indices divided by 3, or UINT32_MAX for
+ * points outside the triangles. The triangles must cover a convex region, as those of triangulation_compute do. The queries
+ * are split between thread_count threads (0 uses every hardware thread); triangles holds query_count values. */
+TRIANGULATION_API triangulation_status triangulation_locate (const float* points, size_t point_count, const uint32_t* indices, size_t index_count, const float* queries, size_t query_count, unsigned int thread_count, uint32_t* triangles);
+
+/* Vertices of a Wavefront OBJ file, all groups concatenated. Capacity and count are in points. */
+TRIANGULATION_API triangulation_status triangulation_read_obj (const char* path, float* points, size_t point_capacity, size_t* point_count);
+
+/* Writes the points and triangles as a Wavefront OBJ file. */
+TRIANGULATION_API triangulation_status triangulation_write_obj (const char* path, const float* points, size_t point_count, const uint32_t* indices, size_t index_count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,25 @@
+#ifndef TRIANGULATION_TESTS_CHECK_HPP
+#define TRIANGULATION_TESTS_CHECK_HPP
+
+#include <iostream>
+#include <string>
+
+// Checks shared by the tests: each failed check is reported, and main returns EXIT_FAILURE if failures is not 0.
+namespace {
+
+    int failures = 0;
+
+    void check (bool condition, std::string const& message) {
+
+        if (!condition) {
+
+            std::cerr << "FAILED: " << message << std::endl;
+            failures++;
+
+        }
+
+    }
+
+}
+
+#endif
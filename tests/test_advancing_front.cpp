@@ -0,0 +1,51 @@
+// Regression test of AdvancingFront: on random points (in general position) its triangulation must be the Delaunay one,
+// every circumcircle empty and as many triangles as SweepHull's.
+#include "AdvancingFront.hpp"
+#include "SweepHull.hpp"
+#include "PointGrid.hpp"
+#include "check.hpp"
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+
+using namespace triangulation;
+
+int main () {
+
+    for (unsigned int seed = 0; seed < 3; seed++) {
+
+        std::mt19937 generator(seed);
+        std::uniform_real_distribution<float> distribution(0.0f, 100.0f);
+        std::vector<glm::vec2> points(400);
+
+        for (auto& point : points) {
+
+            point = glm::vec2(distribution(generator), distribution(generator));
+
+        }
+
+        std::vector<std::uint32_t>
+            indices = AdvancingFront::compute_triangulation_indices(points),
+            reference = SweepHull::compute_triangulation_indices(points);
+        PointGrid grid(points);
+        std::size_t not_delaunay = 0;
+        std::string name = "seed " + std::to_string(seed);
+
+        for (std::size_t t = 0; t + 2 < indices.size(); t += 3) {
+
+            glm::vec2 vertices[3] = {points[indices[t]], points[indices[t + 1]], points[indices[t + 2]]};
+            if (!grid.is_delaunay(vertices)) not_delaunay++;
+
+        }
+
+        check(not_delaunay == 0, name + ": " + std::to_string(not_delaunay) + " triangles are not Delaunay");
+        check(indices.size() == reference.size(), name + ": " + std::to_string(indices.size()/3) + " triangles instead of " + std::to_string(reference.size()/3));
+
+    }
+
+    if (failures > 0) return EXIT_FAILURE;
+    std::cout << "test_advancing_front: OK" << std::endl;
+    return EXIT_SUCCESS;
+
+}
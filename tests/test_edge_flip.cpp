@@ -0,0 +1,146 @@
+// Test of EdgeFlip: grids whose cells are split along shuffled diagonals, the points jittered or not, must become Delaunay
+// with 1 or several threads, the same flips being made in the same rounds whatever the thread count.
+// Also checks parallel_for with a single item and the automatic thread count.
+#include "EdgeFlip.hpp"
+#include "SweepHull.hpp"
+#include "PointGrid.hpp"
+#include "Parallel.hpp"
+#include "check.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+
+using namespace triangulation;
+
+namespace {
+
+    // Counterclockwise triangles with sorted rotations, so that triangulations can be compared.
+    std::vector<std::array<std::uint32_t, 3>> get_triangles (std::vector<std::uint32_t> const& indices) {
+
+        std::vector<std::array<std::uint32_t, 3>> triangles;
+
+        for (std::size_t t = 0; t + 2 < indices.size(); t += 3) {
+
+            std::array<std::uint32_t, 3> triangle = {indices[t], indices[t + 1], indices[t + 2]};
+            std::rotate(triangle.begin(), std::min_element(triangle.begin(), triangle.end()), triangle.end());
+            triangles.push_back(triangle);
+
+        }
+        std::sort(triangles.begin(), triangles.end());
+
+        return triangles;
+
+    }
+
+    void check_grid (std::string const& name, std::size_t columns, std::size_t rows, float jitter, unsigned int seed) {
+
+        std::mt19937 generator(seed);
+        std::uniform_real_distribution<float> offset(-jitter, jitter);
+        std::bernoulli_distribution flip_diagonal(0.5);
+        std::vector<glm::vec2> points;
+        std::vector<std::uint32_t> grid_indices;
+
+        for (std::size_t row = 0; row < rows; row++) {
+
+            for (std::size_t column = 0; column < columns; column++) {
+
+                // The hull points stay on the grid so that the hull edges do not change.
+                bool inside = row > 0 && column > 0 && row + 1 < rows && column + 1 < columns;
+                points.emplace_back(column + (inside ? offset(generator) : 0.0f), row + (inside ? offset(generator) : 0.0f));
+
+            }
+
+        }
+        for (std::size_t row = 0; row + 1 < rows; row++) {
+
+            for (std::size_t column = 0; column + 1 < columns; column++) {
+
+                std::uint32_t
+                    a = static_cast<std::uint32_t>(row*columns + column), b = a + 1,
+                    c = static_cast<std::uint32_t>(a + columns), d = c + 1;
+
+                if (flip_diagonal(generator)) grid_indices.insert(grid_indices.end(), {a, b, d, a, d, c});
+                else grid_indices.insert(grid_indices.end(), {a, b, c, b, d, c});
+
+            }
+
+        }
+
+        PointGrid grid(points);
+        std::vector<std::array<std::uint32_t, 3>> first_triangles;
+        EdgeFlip::Statistics first_statistics;
+
+        for (unsigned int thread_count : {1u, 2u, 4u}) {
+
+            std::vector<std::uint32_t> indices = grid_indices;
+            EdgeFlip::Statistics statistics = EdgeFlip::make_delaunay(points, indices, thread_count);
+            std::string run_name = name + " (" + std::to_string(thread_count) + " threads)";
+            std::size_t not_delaunay = 0;
+
+            for (std::size_t t = 0; t + 2 < indices.size(); t += 3) {
+
+                glm::vec2 vertices[3] = {points[indices[t]], points[indices[t + 1]], points[indices[t + 2]]};
+                if (!grid.is_delaunay(vertices)) not_delaunay++;
+
+            }
+
+            check(statistics.converged, run_name + ": did not converge");
+            check(not_delaunay == 0, run_name + ": " + std::to_string(not_delaunay) + " triangles are not Delaunay");
+            check(indices.size() == grid_indices.size(), run_name + ": " + std::to_string(indices.size()/3) + " triangles instead of " + std::to_string(grid_indices.size()/3));
+            check((statistics.rounds == 0) == (statistics.flips == 0) && statistics.rounds <= statistics.flips, run_name + ": " + std::to_string(statistics.rounds) + " rounds for " + std::to_string(statistics.flips) + " flips");
+            if (jitter > 0.0f) check(statistics.flips > 0, run_name + ": no flips");
+
+            if (thread_count == 1) {
+
+                first_triangles = get_triangles(indices);
+                first_statistics = statistics;
+
+                // Jittered points are in general position: the Delaunay triangulation is unique.
+                if (jitter > 0.0f) check(first_triangles == get_triangles(SweepHull::compute_triangulation_indices(points)), run_name + ": not SweepHull's triangles");
+
+            }
+            else {
+
+                check(get_triangles(indices) == first_triangles, run_name + ": not the triangles of 1 thread");
+                check(statistics.flips == first_statistics.flips && statistics.rounds == first_statistics.rounds,
+                    run_name + ": " + std::to_string(statistics.flips) + " flips in " + std::to_string(statistics.rounds) + " rounds instead of "
+                    + std::to_string(first_statistics.flips) + " in " + std::to_string(first_statistics.rounds));
+
+            }
+
+        }
+
+        if (jitter > 0.0f && first_statistics.rounds > 1) {
+
+            std::vector<std::uint32_t> indices = grid_indices;
+            EdgeFlip::Statistics statistics = EdgeFlip::make_delaunay(points, indices, 2, 1);
+            check(!statistics.converged && statistics.rounds == 1, name + ": max_rounds = 1 not respected");
+
+        }
+
+    }
+
+}
+
+int main () {
+
+    std::atomic<std::size_t> covered(0);
+    triangulation::parallel_for(1, 0, [&] (std::size_t begin, std::size_t end) { covered += end - begin; });
+    check(covered == 1, "parallel_for over 1 item with automatic thread count covered " + std::to_string(covered) + " items");
+
+    check_grid("grid", 16, 14, 0.0f, 0);
+    for (unsigned int seed = 0; seed < 3; seed++) {
+
+        check_grid("jittered grid, seed " + std::to_string(seed), 24, 20, 0.3f, seed);
+
+    }
+
+    if (failures > 0) return EXIT_FAILURE;
+    std::cout << "test_edge_flip: OK" << std::endl;
+    return EXIT_SUCCESS;
+
+}
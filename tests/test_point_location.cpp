@@ -0,0 +1,87 @@
+// Test of PointLocation over SweepHull triangulations of random points: the centroid of every triangle must be located in
+// that triangle, one query at a time and in batches split between several threads, and points outside the hull in none.
+#include "PointLocation.hpp"
+#include "SweepHull.hpp"
+#include "check.hpp"
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+
+using namespace triangulation;
+
+int main () {
+
+    for (unsigned int seed = 0; seed < 3; seed++) {
+
+        std::mt19937 generator(seed);
+        std::uniform_real_distribution<float> distribution(0.0f, 100.0f);
+        std::vector<glm::vec2> points(2000);
+
+        for (auto& point : points) {
+
+            point = glm::vec2(distribution(generator), distribution(generator));
+
+        }
+
+        std::vector<std::uint32_t> indices = SweepHull::compute_triangulation_indices(points);
+        PointLocation location(points, indices);
+        std::vector<glm::vec2> centroids, outside;
+        std::string name = "seed " + std::to_string(seed);
+        std::size_t wrong = 0;
+
+        check(location.get_triangle_count() == indices.size() / 3, name + ": " + std::to_string(location.get_triangle_count()) + " triangles indexed");
+
+        for (std::size_t t = 0; t < indices.size() / 3; t++) {
+
+            centroids.push_back((points[indices[3*t]] + points[indices[3*t + 1]] + points[indices[3*t + 2]]) / 3.0f);
+            if (location.locate(centroids.back()) != t) wrong++;
+
+        }
+        check(wrong == 0, name + ": " + std::to_string(wrong) + " centroids located in another triangle");
+
+        for (unsigned int thread_count : {1u, 3u, 0u}) {
+
+            std::vector<std::uint32_t> triangles = location.locate(centroids, thread_count);
+
+            wrong = 0;
+            for (std::size_t t = 0; t < triangles.size(); t++) {
+
+                if (triangles[t] != t) wrong++;
+
+            }
+            check(triangles.size() == centroids.size() && wrong == 0, name + " (" + std::to_string(thread_count) + " threads): " + std::to_string(wrong) + " centroids located in another triangle");
+
+        }
+
+        // Beyond the bounding box, and a ring around it.
+        for (int i = 0; i < 64; i++) {
+
+            float angle = 6.2831853f * i / 64.0f;
+            outside.emplace_back(50.0f + 80.0f * std::cos(angle), 50.0f + 80.0f * std::sin(angle));
+
+        }
+        outside.emplace_back(-1.0f, 50.0f);
+        outside.emplace_back(50.0f, 101.0f);
+
+        wrong = 0;
+        for (auto const& point : outside) {
+
+            if (location.locate(point) != PointLocation::no_triangle) wrong++;
+
+        }
+        for (auto const& triangle : location.locate(outside, 3)) {
+
+            if (triangle != PointLocation::no_triangle) wrong++;
+
+        }
+        check(wrong == 0, name + ": " + std::to_string(wrong) + " points outside the hull located in a triangle");
+
+    }
+
+    if (failures > 0) return EXIT_FAILURE;
+    std::cout << "test_point_location: OK" << std::endl;
+    return EXIT_SUCCESS;
+
+}
@@ -0,0 +1,104 @@
+// Test of PointSnapper: the first kept point within tolerance wins, cells a multiple of 2^32 apart (whose keys wrap to the same
+// value) are not merged, -0 and 0 are the same point for exact snapping, and the remap table resolves indices into each group.
+#include "PointSnapper.hpp"
+#include "check.hpp"
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+using namespace triangulation;
+
+int main () {
+
+    // The point at 0.3 is within tolerance of both kept points and closer to the second one, whose cell is visited first.
+    PointSnapper::Result result = PointSnapper::snap({{1.2f, 0.0f}, {-0.3f, 0.0f}, {0.3f, 0.0f}}, 1.0f);
+    check(result.points.size() == 2 && result.remap[2] == 0, "first kept point: merged into point " + std::to_string(result.remap[2]));
+
+    // Columns 0 and 2^32 have the same cell key, columns -1 and 0 are neighbours across the wrap of the key.
+    result = PointSnapper::snap({{0.0f, 0.0f}, {4294967296.0f, 0.0f}, {0.0f, 4294967296.0f}, {-0.5f, 0.0f}}, 1.0f);
+    check(result.points.size() == 3, "cell key wrap: " + std::to_string(result.points.size()) + " points kept instead of 3");
+    check(result.remap[1] == 1 && result.remap[2] == 2, "cell key wrap: points 2^32 cells away merged");
+    check(result.remap[3] == 0, "cell key wrap: neighbour in column -1 not merged");
+
+    result = PointSnapper::snap({{-0.0f, 0.0f}, {0.0f, -0.0f}, {0.0f, 0.0f}, {-0.0f, -0.0f}, {1.0f, 0.0f}});
+    check(result.points.size() == 2, "-0: " + std::to_string(result.points.size()) + " points kept instead of 2");
+    check(result.remap[1] == 0 && result.remap[2] == 0 && result.remap[3] == 0 && result.remap[4] == 1, "-0: not merged with 0");
+
+    // Two groups sharing an edge, as main concatenates them: indices into a group, shifted by its offset, find the merged point.
+    std::vector<std::vector<glm::vec2>> groups = {{{0.0f, 0.0f}, {1.0f, 0.0f}, {0.0f, 1.0f}}, {{1.0f, 0.0f}, {1.0f, 1.0f}, {0.0f, 1.0f}}};
+    std::vector<glm::vec2> points;
+    for (auto const& group : groups) {
+
+        points.insert(points.end(), group.begin(), group.end());
+
+    }
+    for (float tolerance : {0.0f, 0.1f}) {
+
+        result = PointSnapper::snap(points, tolerance);
+        std::size_t offset = 0, wrong = 0;
+
+        for (auto const& group : groups) {
+
+            for (std::size_t j = 0; j < group.size(); j++) {
+
+                if (result.points[result.remap[offset + j]] != group[j]) wrong++;
+
+            }
+            offset += group.size();
+
+        }
+        check(result.points.size() == 4 && wrong == 0, "remap (tolerance " + std::to_string(tolerance) + "): " + std::to_string(result.points.size()) + " points, " + std::to_string(wrong) + " wrong group indices");
+
+    }
+
+    // Random clusters: every point is within tolerance of its kept point, and kept points are farther apart than the tolerance.
+    std::mt19937 generator(0);
+    std::uniform_real_distribution<float> distribution(-50.0f, 50.0f), jitter(-0.2f, 0.2f);
+    points.clear();
+    for (int i = 0; i < 2000; i++) {
+
+        glm::vec2 center(std::round(distribution(generator)), std::round(distribution(generator)));
+        points.emplace_back(center.x + jitter(generator), center.y + jitter(generator));
+
+    }
+    result = PointSnapper::snap(points, 0.5f);
+
+    std::size_t too_far = 0, too_close = 0;
+    for (std::size_t i = 0; i < points.size(); i++) {
+
+        glm::vec2 difference = result.points[result.remap[i]] - points[i];
+        if (std::sqrt(difference.x * difference.x + difference.y * difference.y) > 0.5f) too_far++;
+
+    }
+    for (std::size_t i = 0; i < result.points.size(); i++) {
+
+        for (std::size_t j = i + 1; j < result.points.size(); j++) {
+
+            glm::vec2 difference = result.points[i] - result.points[j];
+            if (std::sqrt(difference.x * difference.x + difference.y * difference.y) <= 0.5f) too_close++;
+
+        }
+
+    }
+    check(too_far == 0 && too_close == 0, "random clusters: " + std::to_string(too_far) + " points merged too far, " + std::to_string(too_close) + " kept points too close");
+
+    bool thrown = false;
+    try {
+
+        PointSnapper::snap(points, -1.0f);
+
+    } catch (std::invalid_argument const&) {
+
+        thrown = true;
+
+    }
+    check(thrown, "negative tolerance accepted");
+
+    if (failures > 0) return EXIT_FAILURE;
+    std::cout << "test_point_snapper: OK" << std::endl;
+    return EXIT_SUCCESS;
+
+}
@@ -0,0 +1,105 @@
+// Test of QuickHull: compute_hull and merge_hulls must give the same vertices for the same points, clockwise and without
+// collinear points, on random points and on grids (collinear points on every hull edge) in several point orders.
+#include "QuickHull.hpp"
+#include "check.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+
+using namespace triangulation;
+
+namespace {
+
+    double turn (glm::vec2 const& o, glm::vec2 const& a, glm::vec2 const& b) {
+
+        return (static_cast<double>(a.x) - o.x) * (static_cast<double>(b.y) - o.y) - (static_cast<double>(a.y) - o.y) * (static_cast<double>(b.x) - o.x);
+
+    }
+
+    void check_hulls (std::string const& name, std::vector<glm::vec2> const& points) {
+
+        std::vector<glm::vec2> hull = QuickHull::compute_hull(points);
+        std::vector<std::vector<glm::vec2>> group_hulls(4);
+
+        // Every vertex must turn clockwise, strictly.
+        std::size_t bad_turns = 0;
+        for (std::size_t i = 0; i < hull.size(); i++) {
+
+            if (turn(hull[i], hull[(i + 1) % hull.size()], hull[(i + 2) % hull.size()]) >= 0.0) bad_turns++;
+
+        }
+        check(hull.size() >= 3 && bad_turns == 0, name + ": " + std::to_string(bad_turns) + " of " + std::to_string(hull.size()) + " hull vertices are not strictly clockwise");
+
+        check(QuickHull::merge_hulls(hull, hull) == hull, name + ": merging the hull with itself changes it");
+
+        // Hulls of interleaved groups, merged back, must give the hull of all the points.
+        for (std::size_t group = 0; group < group_hulls.size(); group++) {
+
+            std::vector<glm::vec2> group_points;
+
+            for (std::size_t i = group; i < points.size(); i += group_hulls.size()) {
+
+                group_points.push_back(points[i]);
+
+            }
+            group_hulls[group] = QuickHull::compute_hull(group_points);
+
+        }
+        check(QuickHull::merge_hulls(group_hulls) == hull, name + ": merged group hulls differ from the hull");
+
+    }
+
+}
+
+int main () {
+
+    std::mt19937 generator(0);
+    std::uniform_real_distribution<float> distribution(0.0f, 100.0f);
+    std::vector<glm::vec2> points(2000);
+
+    for (auto& point : points) {
+
+        point = glm::vec2(distribution(generator), distribution(generator));
+
+    }
+    check_hulls("random", points);
+
+    std::vector<glm::vec2> grid;
+    for (int x = 0; x < 16; x++) {
+
+        for (int y = 0; y < 14; y++) {
+
+            grid.emplace_back(5.0f * x, 5.0f * y);
+
+        }
+
+    }
+    check_hulls("grid", grid);
+
+    std::reverse(grid.begin(), grid.end());
+    check_hulls("reversed grid", grid);
+
+    std::shuffle(grid.begin(), grid.end(), generator);
+    check_hulls("shuffled grid", grid);
+
+    // A grid rotated by 45 degrees has collinear points on edges that are not vertical.
+    std::vector<glm::vec2> diamond;
+    for (int x = 0; x < 12; x++) {
+
+        for (int y = 0; y < 9; y++) {
+
+            diamond.emplace_back(static_cast<float>(x + y), static_cast<float>(x - y));
+
+        }
+
+    }
+    std::shuffle(diamond.begin(), diamond.end(), generator);
+    check_hulls("diamond grid", diamond);
+
+    if (failures > 0) return EXIT_FAILURE;
+    std::cout << "test_quickhull: OK" << std::endl;
+    return EXIT_SUCCESS;
+
+}
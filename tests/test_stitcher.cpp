@@ -0,0 +1,163 @@
+// Regression test of Stitcher: the stitched triangulation of groups triangulated by AdvancingFront must cover the convex hull
+// exactly once, like SweepHull's triangulation of the whole set, on random points and on a grid (cocircular points).
+#include "Stitcher.hpp"
+#include "SweepHull.hpp"
+#include "AdvancingFront.hpp"
+#include "check.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <random>
+#include <set>
+#include <string>
+
+using namespace triangulation;
+
+namespace {
+
+    double get_area (std::vector<glm::vec2> const& points, std::vector<std::uint32_t> const& indices) {
+
+        double area = 0.0;
+
+        for (std::size_t t = 0; t + 2 < indices.size(); t += 3) {
+
+            glm::dvec2 a(points[indices[t]]), b(points[indices[t + 1]]), c(points[indices[t + 2]]);
+            area += std::abs((b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x)) / 2.0;
+
+        }
+
+        return area;
+
+    }
+
+    // Every edge is shared by at most two triangles, and the edges of a single triangle form one closed boundary: as many of them
+    // as boundary vertices.
+    bool is_manifold (std::vector<std::uint32_t> const& indices) {
+
+        std::map<std::pair<std::uint32_t, std::uint32_t>, int> edge_counts;
+        std::set<std::uint32_t> boundary_vertices;
+        std::size_t boundary_edges = 0;
+
+        for (std::size_t t = 0; t + 2 < indices.size(); t += 3) {
+
+            for (std::size_t k = 0; k < 3; k++) {
+
+                std::uint32_t v1 = indices[t + k], v2 = indices[t + (k + 1) % 3];
+                edge_counts[{std::min(v1, v2), std::max(v1, v2)}]++;
+
+            }
+
+        }
+        for (auto const& [edge, count] : edge_counts) {
+
+            if (count > 2) return false;
+            if (count == 1) {
+
+                boundary_edges++;
+                boundary_vertices.insert(edge.first);
+                boundary_vertices.insert(edge.second);
+
+            }
+
+        }
+
+        return boundary_edges == boundary_vertices.size();
+
+    }
+
+    std::set<std::array<std::uint32_t, 3>> get_triangle_set (std::vector<std::uint32_t> const& indices) {
+
+        std::set<std::array<std::uint32_t, 3>> triangles;
+
+        for (std::size_t t = 0; t + 2 < indices.size(); t += 3) {
+
+            std::array<std::uint32_t, 3> triangle = {indices[t], indices[t + 1], indices[t + 2]};
+            std::sort(triangle.begin(), triangle.end());
+            triangles.insert(triangle);
+
+        }
+
+        return triangles;
+
+    }
+
+    // Splits the points into vertical strips plus one group scattered over the whole set, so groups both touch and overlap.
+    void check_stitch (std::string const& name, std::vector<glm::vec2> const& points, bool is_in_general_position) {
+
+        std::vector<std::vector<glm::vec2>> groups(4);
+        std::vector<std::vector<std::uint32_t>> group_triangulations;
+        std::vector<glm::vec2> concatenated;
+        glm::vec2 min_corner = points[0], max_corner = points[0];
+
+        for (auto const& point : points) {
+
+            min_corner = glm::min(min_corner, point);
+            max_corner = glm::max(max_corner, point);
+
+        }
+        for (std::size_t i = 0; i < points.size(); i++) {
+
+            std::size_t strip = std::min<std::size_t>(2, static_cast<std::size_t>(3.0f * (points[i].x - min_corner.x) / (max_corner.x - min_corner.x)));
+            groups[(i % 5 == 0) ? 3 : strip].push_back(points[i]);
+
+        }
+        for (auto const& group : groups) {
+
+            group_triangulations.push_back(AdvancingFront::compute_triangulation_indices(group));
+            concatenated.insert(concatenated.end(), group.begin(), group.end());
+
+        }
+
+        std::vector<std::uint32_t>
+            stitched = Stitcher::stitch(groups, group_triangulations),
+            reference = SweepHull::compute_triangulation_indices(concatenated);
+        double
+            stitched_area = get_area(concatenated, stitched),
+            reference_area = get_area(concatenated, reference);
+
+        check(std::abs(stitched_area - reference_area) <= 1e-6 * reference_area, name + ": stitched area " + std::to_string(stitched_area) + " instead of " + std::to_string(reference_area));
+        check(is_manifold(stitched), name + ": stitched triangulation is not manifold");
+        check(stitched.size() == reference.size(), name + ": " + std::to_string(stitched.size()/3) + " stitched triangles instead of " + std::to_string(reference.size()/3));
+        if (is_in_general_position) check(get_triangle_set(stitched) == get_triangle_set(reference), name + ": stitched triangles differ from SweepHull's");
+
+    }
+
+}
+
+int main () {
+
+    for (unsigned int seed = 0; seed < 3; seed++) {
+
+        std::mt19937 generator(seed);
+        std::uniform_real_distribution<float> distribution(0.0f, 100.0f);
+        std::vector<glm::vec2> points(300);
+
+        for (auto& point : points) {
+
+            point = glm::vec2(distribution(generator), distribution(generator));
+
+        }
+        check_stitch("random " + std::to_string(seed), points, true);
+
+    }
+
+    std::vector<glm::vec2> grid;
+    for (int x = 0; x < 16; x++) {
+
+        for (int y = 0; y < 14; y++) {
+
+            grid.emplace_back(10.0f * x, 10.0f * y);
+
+        }
+
+    }
+    check_stitch("grid", grid, false);
+
+    if (failures > 0) return EXIT_FAILURE;
+    std::cout << "test_stitcher: OK" << std::endl;
+    return EXIT_SUCCESS;
+
+}
@@ -0,0 +1,62 @@
+// Test of TriangleRingBuffer: an AdvancingFront run using a small buffer as its sink, emptied by a consumer on another thread
+// in batches of varying size (including 0, which still pops a triangle), must deliver compute_triangulation_indices's triangles
+// in the same order.
+#include "TriangleRingBuffer.hpp"
+#include "AdvancingFront.hpp"
+#include "check.hpp"
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+
+using namespace triangulation;
+
+int main () {
+
+    std::mt19937 generator(0);
+    std::uniform_real_distribution<float> distribution(0.0f, 100.0f);
+    std::vector<glm::vec2> points(300);
+
+    for (auto& point : points) {
+
+        point = glm::vec2(distribution(generator), distribution(generator));
+
+    }
+
+    std::vector<std::uint32_t> reference = AdvancingFront::compute_triangulation_indices(points), indices;
+    TriangleRingBuffer buffer(16);
+    std::size_t pops = 0, oversized_pops = 0, late_triangles = 0;
+
+    std::thread producer([&points, &buffer] () {
+
+        AdvancingFront::compute_triangulation(points, buffer);
+        buffer.close();
+
+    });
+
+    // Batches of 0 to 9 triangles: the loop only ends once the producer closed the buffer and every triangle was popped.
+    while (true) {
+
+        std::size_t max_count = pops % 10, count = buffer.pop(indices, max_count);
+
+        if (count == 0) break;
+        if (count > std::max<std::size_t>(1, max_count)) oversized_pops++;
+        pops++;
+
+    }
+
+    // Popping one at a time until the end, so that the producer never stays blocked if the loop above ended early.
+    std::vector<std::uint32_t> late_indices;
+    while (buffer.pop(late_indices, 1) > 0) late_triangles++;
+    producer.join();
+
+    check(late_triangles == 0, "a pop returned 0 with " + std::to_string(late_triangles) + " triangles still to come");
+    check(oversized_pops == 0, std::to_string(oversized_pops) + " pops returned more triangles than asked for");
+    check(indices == reference, std::to_string(indices.size()/3) + " triangles popped instead of the " + std::to_string(reference.size()/3) + " of compute_triangulation_indices");
+
+    if (failures > 0) return EXIT_FAILURE;
+    std::cout << "test_triangle_ring_buffer: OK" << std::endl;
+    return EXIT_SUCCESS;
+
+}
@@ -0,0 +1,127 @@
+// Test of Voronoi: the cells of the SweepHull triangulation, clipped to the bounding box or the convex hull, must contain their
+// point and tile the clip polygon exactly, on random points and on a grid (cocircular points).
+#include "Voronoi.hpp"
+#include "SweepHull.hpp"
+#include "QuickHull.hpp"
+#include "check.hpp"
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+
+using namespace triangulation;
+
+namespace {
+
+    double get_polygon_area (std::vector<glm::dvec2> const& polygon) {
+
+        double area = 0.0;
+
+        for (std::size_t i = 0; i < polygon.size(); i++) {
+
+            glm::dvec2 a = polygon[i], b = polygon[(i + 1) % polygon.size()];
+            area += a.x * b.y - a.y * b.x;
+
+        }
+
+        return std::abs(area) / 2.0;
+
+    }
+
+    void check_diagram (std::string const& name, std::vector<glm::vec2> const& points) {
+
+        std::vector<std::uint32_t> indices = SweepHull::compute_triangulation_indices(points);
+        glm::vec2 min_corner = points[0], max_corner = points[0];
+        std::vector<glm::dvec2> hull;
+
+        for (auto const& point : points) {
+
+            min_corner = glm::min(min_corner, point);
+            max_corner = glm::max(max_corner, point);
+
+        }
+        for (auto const& point : QuickHull::compute_hull(points)) {
+
+            hull.emplace_back(point);
+
+        }
+
+        double
+            box_area = (static_cast<double>(max_corner.x) - min_corner.x) * (static_cast<double>(max_corner.y) - min_corner.y),
+            hull_area = get_polygon_area(hull);
+
+        for (VoronoiClip clip_mode : {BOUNDING_BOX, CONVEX_HULL}) {
+
+            VoronoiDiagram diagram = Voronoi::compute_diagram(points, indices, clip_mode, 2);
+            std::string mode_name = name + ((clip_mode == BOUNDING_BOX) ? " (bounding box)" : " (convex hull)");
+            double total_area = 0.0;
+            std::size_t sites_outside = 0;
+
+            check(diagram.get_cell_count() == points.size(), mode_name + ": wrong cell count");
+
+            for (std::size_t v = 0; v < diagram.get_cell_count(); v++) {
+
+                std::vector<glm::dvec2> cell;
+                for (std::uint32_t i = diagram.cell_offsets[v]; i < diagram.cell_offsets[v + 1]; i++) {
+
+                    cell.emplace_back(diagram.vertices_x[i], diagram.vertices_y[i]);
+
+                }
+                total_area += get_polygon_area(cell);
+
+                // The cells are counterclockwise and convex, so their point is on the left of every side.
+                for (std::size_t i = 0; i < cell.size(); i++) {
+
+                    glm::dvec2 side = cell[(i + 1) % cell.size()] - cell[i], offset = glm::dvec2(points[v]) - cell[i];
+                    if (side.x * offset.y - side.y * offset.x < -1e-3 * glm::length(side)) {
+
+                        sites_outside++;
+                        break;
+
+                    }
+
+                }
+
+            }
+
+            double expected_area = (clip_mode == BOUNDING_BOX) ? box_area : hull_area;
+            check(std::abs(total_area - expected_area) <= 1e-4 * expected_area, mode_name + ": cells cover " + std::to_string(total_area) + " instead of " + std::to_string(expected_area));
+            check(sites_outside == 0, mode_name + ": " + std::to_string(sites_outside) + " points outside their cell");
+
+        }
+
+    }
+
+}
+
+int main () {
+
+    std::mt19937 generator(0);
+    std::uniform_real_distribution<float> distribution(0.0f, 100.0f);
+    std::vector<glm::vec2> points(2000);
+
+    for (auto& point : points) {
+
+        point = glm::vec2(distribution(generator), distribution(generator));
+
+    }
+    check_diagram("random", points);
+
+    std::vector<glm::vec2> grid;
+    for (int x = 0; x < 30; x++) {
+
+        for (int y = 0; y < 20; y++) {
+
+            grid.emplace_back(5.0f * x, 5.0f * y);
+
+        }
+
+    }
+    check_diagram("grid", grid);
+
+    if (failures > 0) return EXIT_FAILURE;
+    std::cout << "test_voronoi: OK" << std::endl;
+    return EXIT_SUCCESS;
+
+}